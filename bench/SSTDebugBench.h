@@ -0,0 +1,207 @@
+//
+// _SSTDebugBench_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGBENCH_H_
+#define _SSTDEBUGBENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdlib.h>
+
+#ifdef SSTDBG_ASCII
+#define SSTDBG_BENCH_FORMAT "ascii"
+#else
+#define SSTDBG_BENCH_FORMAT "json"
+#endif
+
+// BENCHPARAMS: the problem size of a measurement, e.g. {{"comps",64}}
+typedef std::vector<std::pair<std::string,uint64_t>> BENCHPARAMS;
+
+// SSTDebugBench: shared driver of the sst-dbg benchmarks
+//
+// Every measurement is repeated and emitted as a single JSON object per
+// line (to stdout and, with -o, appended to a results file) so results of
+// successive releases can be collected and compared by tools:
+//
+//   {"suite":"dump","bench":"scalar","format":"json","params":{"keys":4},
+//    "ops":20000,"reps":5,"best_ns_per_op":..,"median_ns_per_op":..,
+//    "ops_per_sec":..,"mb_per_sec":..,"time":..}
+//
+// Options:
+//   -q|--quick      : divide the problem sizes by 10
+//   -r|--reps N     : repetitions of every measurement (default 5)
+//   -o|--out FILE   : append the results to FILE
+//   -d|--dir DIR    : create the scratch run directories below DIR
+//   -k|--keep       : keep the scratch run directories
+//   -D|--data DIR   : measure an existing run directory (e.g., one written
+//                     by sstdbg_gen) rather than generated ones
+class SSTDebugBench {
+public:
+  SSTDebugBench(const std::string& Suite, int argc, char **argv)
+    : Suite(Suite), Base("."){
+    for( int i=1; i<argc; i++ ){
+      std::string Arg(argv[i]);
+      if( (Arg == "-q") || (Arg == "--quick") ){
+        QuickMode = true;
+      }else if( ((Arg == "-r") || (Arg == "--reps")) && (i+1 < argc) ){
+        Reps = std::max(1, std::atoi(argv[++i]));
+      }else if( ((Arg == "-o") || (Arg == "--out")) && (i+1 < argc) ){
+        Out.open(argv[++i], std::ios::out | std::ios::app);
+      }else if( ((Arg == "-d") || (Arg == "--dir")) && (i+1 < argc) ){
+        Base = argv[++i];
+      }else if( (Arg == "-k") || (Arg == "--keep") ){
+        Keep = true;
+      }else if( ((Arg == "-D") || (Arg == "--data")) && (i+1 < argc) ){
+        Data = argv[++i];
+      }else{
+        std::cerr << "usage: " << argv[0]
+                  << " [--quick] [--reps N] [--out FILE] [--dir DIR] [--keep] [--data DIR]"
+                  << std::endl;
+        std::exit(-1);
+      }
+    }
+  }
+
+  ~SSTDebugBench(){
+    if( Keep )
+      return;
+    for( auto const& D : Scratch ){
+      std::error_code ec;
+      std::filesystem::remove_all(D, ec);
+    }
+  }
+
+  /// SSTDebugBench: number of repetitions of every measurement
+  unsigned GetReps() const { return (unsigned)(Reps); }
+
+  /// SSTDebugBench: existing run directory to measure; empty if none
+  const std::string& GetData() const { return Data; }
+
+  /// SSTDebugBench: scales a problem size down in quick mode
+  uint64_t Size(uint64_t N) const {
+    return QuickMode ? std::max<uint64_t>(1, N / 10) : N;
+  }
+
+  /// SSTDebugBench: creates an empty scratch run directory; removed on exit
+  std::string ScratchDir(const std::string& Tag){
+    std::string T = Base + "/sstdbg-bench-" + Suite + "-" + Tag + ".XXXXXX";
+    std::vector<char> Buf(T.begin(), T.end());
+    Buf.push_back('\0');
+    if( mkdtemp(Buf.data()) == nullptr ){
+      std::cerr << "unable to create a scratch directory below " << Base << std::endl;
+      std::exit(-1);
+    }
+    Scratch.push_back(Buf.data());
+    return Scratch.back() + "/";
+  }
+
+  /// SSTDebugBench: removes the files of a scratch run directory
+  static void Clear(const std::string& Dir){
+    std::error_code ec;
+    for( auto const& E : std::filesystem::directory_iterator(Dir, ec) )
+      std::filesystem::remove(E.path(), ec);
+  }
+
+  /// SSTDebugBench: number of files and bytes in a run directory
+  static std::pair<uint64_t,uint64_t> DirSize(const std::string& Dir){
+    uint64_t Files = 0;
+    uint64_t Bytes = 0;
+    std::error_code ec;
+    for( auto const& E : std::filesystem::directory_iterator(Dir, ec) ){
+      if( E.is_regular_file(ec) ){
+        Files++;
+        Bytes += E.file_size(ec);
+      }
+    }
+    return std::make_pair(Files, Bytes);
+  }
+
+  /// SSTDebugBench: times a single call of Fn in seconds
+  template<typename F>
+  static double Time(F&& Fn){
+    auto Start = std::chrono::steady_clock::now();
+    Fn();
+    std::chrono::duration<double> D = std::chrono::steady_clock::now() - Start;
+    return D.count();
+  }
+
+  /// SSTDebugBench: runs Setup (untimed) then Fn (timed) once per repetition
+  template<typename S, typename F>
+  std::vector<double> Measure(S&& Setup, F&& Fn){
+    std::vector<double> Secs;
+    for( int r=0; r<Reps; r++ ){
+      Setup();
+      Secs.push_back(Time(Fn));
+    }
+    return Secs;
+  }
+
+  /// SSTDebugBench: runs Fn once per repetition
+  template<typename F>
+  std::vector<double> Measure(F&& Fn){
+    return Measure([](){}, Fn);
+  }
+
+  /// SSTDebugBench: writes the result of a measurement
+  /// Ops operations were performed per repetition, moving Bytes bytes
+  void Emit(const std::string& Bench, const BENCHPARAMS& Params,
+            uint64_t Ops, std::vector<double> Secs, uint64_t Bytes = 0){
+    if( Secs.empty() || (Ops == 0) )
+      return;
+    std::sort(Secs.begin(), Secs.end());
+    const double Best   = Secs.front();
+    const double Median = Secs[Secs.size()/2];
+
+    std::ostringstream os;
+    os << "{\"suite\":\"" << Suite << "\",\"bench\":\"" << Bench
+       << "\",\"format\":\"" << SSTDBG_BENCH_FORMAT << "\",\"params\":{";
+    for( size_t i=0; i<Params.size(); i++ ){
+      if( i )
+        os << ",";
+      os << "\"" << Params[i].first << "\":" << Params[i].second;
+    }
+    os << "},\"ops\":" << Ops << ",\"reps\":" << Secs.size()
+       << ",\"best_ns_per_op\":" << (Best * 1e9 / Ops)
+       << ",\"median_ns_per_op\":" << (Median * 1e9 / Ops)
+       << ",\"ops_per_sec\":" << (Best > 0 ? (Ops / Best) : 0.0);
+    if( Bytes )
+      os << ",\"bytes\":" << Bytes
+         << ",\"mb_per_sec\":" << (Best > 0 ? (Bytes / Best / 1048576.0) : 0.0);
+    os << ",\"time\":" << (uint64_t)(std::time(nullptr)) << "}";
+
+    std::cout << os.str() << std::endl;
+    if( Out.is_open() )
+      Out << os.str() << std::endl;
+  }
+
+private:
+  std::string Suite;                  ///< Name of the benchmark program
+  std::string Base;                   ///< Parent of the scratch directories
+  std::string Data;                   ///< Existing run directory to measure
+  std::vector<std::string> Scratch;   ///< Scratch directories created
+  std::ofstream Out;                  ///< Results file
+  bool QuickMode = false;             ///< Are the problem sizes reduced?
+  bool Keep = false;                  ///< Are the scratch directories kept?
+  int Reps = 5;                       ///< Repetitions of every measurement
+};
+
+#endif  // #ifndef _SSTDEBUGBENCH_H_
+
+// EOF
@@ -0,0 +1,263 @@
+//
+// _SSTDebugGen_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGGEN_H_
+#define _SSTDEBUGGEN_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "SSTDebug.h"
+
+// GENOPTS: the shape of a synthetic run directory
+typedef struct{
+  std::string Dir;        // run directory; must exist
+  uint64_t Comps;         // number of components
+  uint64_t Cycles;        // dumps per component
+  uint64_t Interval;      // simulated cycles between dumps
+  unsigned Keys;          // values per record
+  double Entropy;         // fraction of the values changing between dumps
+  unsigned Ranks;         // writer processes; the MPI ranks in MPI builds
+  unsigned Threads;       // writer threads per rank
+  uint64_t Seed;          // random seed; equal seeds produce equal runs
+}GENOPTS;
+
+// GENRESULT: what a generator run wrote
+typedef struct{
+  uint64_t Records;       // dump records written
+  uint64_t Bytes;         // bytes written
+}GENRESULT;
+
+// SSTDebugGen: writes a synthetic run directory through SSTDebug
+//
+// Every component registers Keys watch variables of four kinds, as found
+// in SST components: event counters, utilizations, state names and queue
+// occupancies.  Each dump, a value changes with probability Entropy, so
+// 0 yields identical records and 1 yields a fresh value for every key.
+// Components are named after common SST element types (core12, l2_13, ...).
+//
+// Components are spread round-robin over the ranks, then over the
+// threads of a rank; every thread clocks its components through all of
+// the cycles.  Without MPI, each rank is a forked process writing into
+// the shared directory, as an MPI run of a build without SSTDBG_MPI does.
+// With SSTDBG_MPI, the caller has initialized MPI and every rank writes
+// its own per-thread shards.
+class SSTDebugGen {
+public:
+  /// SSTDebugGen: returns the default generator options
+  static GENOPTS Defaults(){
+    GENOPTS O;
+    O.Dir      = "./";
+    O.Comps    = 64;
+    O.Cycles   = 16;
+    O.Interval = 1000;
+    O.Keys     = 8;
+    O.Entropy  = 0.5;
+    O.Ranks    = 1;
+    O.Threads  = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    O.Seed     = 1;
+    return O;
+  }
+
+  /// SSTDebugGen: returns the name of the component Id
+  static std::string CompName(uint64_t Id){
+    static const char *Types[] = {"core", "l1d", "l1i", "l2_", "dir", "memctrl", "nic", "router"};
+    return Types[Id % 8] + std::to_string(Id);
+  }
+
+  /// SSTDebugGen: returns the cycle of the Nth dump
+  static uint64_t Cycle(const GENOPTS& O, uint64_t N){ return N * O.Interval; }
+
+  /// SSTDebugGen: writes the run directory; returns the totals of every rank
+  static GENRESULT Run(const GENOPTS& O){
+#ifdef SSTDBG_MPI
+    int Rank = 0;
+    int Size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &Rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &Size);
+    GENRESULT R = RunRank(O, (unsigned)(Rank), (unsigned)(Size));
+    uint64_t Local[2] = {R.Records, R.Bytes};
+    uint64_t Total[2] = {0, 0};
+    MPI_Allreduce(Local, Total, 2, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+    R.Records = Total[0];
+    R.Bytes   = Total[1];
+    return R;
+#else
+    if( O.Ranks <= 1 )
+      return RunRank(O, 0, 1);
+
+    // one process per rank; each reports its totals through a pipe
+    GENRESULT R = {0, 0};
+    std::vector<std::pair<pid_t,int>> Children;
+    for( unsigned r=0; r<O.Ranks; r++ ){
+      int fd[2];
+      if( pipe(fd) == -1 )
+        break;
+      pid_t pid = fork();
+      if( pid == 0 ){
+        close(fd[0]);
+        GENRESULT C = RunRank(O, r, O.Ranks);
+        ssize_t n = write(fd[1], &C, sizeof(C));
+        close(fd[1]);
+        _exit(n == (ssize_t)(sizeof(C)) ? 0 : 1);
+      }
+      close(fd[1]);
+      if( pid == -1 ){
+        close(fd[0]);
+        break;
+      }
+      Children.push_back(std::make_pair(pid, fd[0]));
+    }
+    for( auto const& C : Children ){
+      GENRESULT CR = {0, 0};
+      if( read(C.second, &CR, sizeof(CR)) == (ssize_t)(sizeof(CR)) ){
+        R.Records += CR.Records;
+        R.Bytes   += CR.Bytes;
+      }
+      close(C.second);
+      int status = 0;
+      waitpid(C.first, &status, 0);
+    }
+    return R;
+#endif
+  }
+
+private:
+  /// SSTDebugGen: the state of a synthetic component
+  struct COMP {
+    std::unique_ptr<SSTDebug> Dbg;
+    std::vector<uint64_t> Counters;     // monotonic event counters
+    std::vector<double> Utils;          // utilizations in [0,1)
+    std::vector<std::string> States;    // state machine names
+    std::vector<uint32_t> Queues;       // 4 entry queue occupancies
+  };
+
+  /// SSTDebugGen: xorshift64*; cheap enough not to skew the write rate
+  static uint64_t Next(uint64_t& S){
+    S ^= S >> 12;
+    S ^= S << 25;
+    S ^= S >> 27;
+    return S * 0x2545f4914f6cdd1dull;
+  }
+
+  /// SSTDebugGen: does the next value change?
+  static bool Changes(uint64_t& S, uint64_t Cut){
+    return (Next(S) >> 32) < Cut;
+  }
+
+  static const char *State(uint64_t V){
+    static const char *States[] = {"IDLE", "BUSY", "STALL", "WAIT", "FLUSH"};
+    return States[V % 5];
+  }
+
+  /// SSTDebugGen: writes the components of one thread of a rank
+  static GENRESULT RunThread(const GENOPTS& O, unsigned Rank, unsigned Ranks,
+                             unsigned Thread, unsigned Threads){
+    // the components are created on their writer thread, as in SST
+    std::vector<COMP> Comps;
+    for( uint64_t Id=Rank; Id<O.Comps; Id+=Ranks ){
+      if( ((Id / Ranks) % Threads) != Thread )
+        continue;
+      Comps.emplace_back();
+      COMP &C = Comps.back();
+      C.Dbg.reset(new SSTDebug(CompName(Id), O.Dir));
+      // storage is sized up front; the watches hold its addresses
+      const unsigned Kinds[4] = {(O.Keys + 3) / 4, (O.Keys + 2) / 4,
+                                 (O.Keys + 1) / 4, O.Keys / 4};
+      C.Counters.resize(Kinds[0]);
+      C.Utils.resize(Kinds[1]);
+      C.States.resize(Kinds[2]);
+      C.Queues.resize(4 * Kinds[3]);
+      uint64_t S = (O.Seed + Id) * 0x9e3779b97f4a7c15ull | 1;
+      for( unsigned k=0; k<O.Keys; k++ ){
+        const unsigned i = k / 4;
+        switch( k % 4 ){
+        case 0:
+          C.Counters[i] = Next(S) % 1024;
+          C.Dbg->watch("count" + std::to_string(i), &C.Counters[i]);
+          break;
+        case 1:
+          C.Utils[i] = double(Next(S) >> 11) / 9007199254740992.0;
+          C.Dbg->watch("util" + std::to_string(i), &C.Utils[i]);
+          break;
+        case 2:
+          C.States[i] = State(Next(S));
+          C.Dbg->watch("state" + std::to_string(i), &C.States[i]);
+          break;
+        default:
+          C.Dbg->watch("queue" + std::to_string(i), &C.Queues[4*i], 4);
+          break;
+        }
+      }
+    }
+
+    const uint64_t Cut = (O.Entropy >= 1.0) ? (1ull << 32) :
+                         (O.Entropy <= 0.0) ? 0 : (uint64_t)(O.Entropy * 4294967296.0);
+    uint64_t S = (O.Seed ^ ((uint64_t)(Rank) << 32) ^ Thread) * 0x9e3779b97f4a7c15ull | 1;
+    for( uint64_t n=0; n<O.Cycles; n++ ){
+      for( auto& C : Comps ){
+        if( n ){
+          for( auto& V : C.Counters )
+            if( Changes(S, Cut) )
+              V += 1 + (Next(S) % 64);
+          for( auto& V : C.Utils )
+            if( Changes(S, Cut) )
+              V = double(Next(S) >> 11) / 9007199254740992.0;
+          for( auto& V : C.States )
+            if( Changes(S, Cut) )
+              V = State(Next(S));
+          for( auto& V : C.Queues )
+            if( Changes(S, Cut) )
+              V = (uint32_t)(Next(S) % 16);
+        }
+        C.Dbg->snapshot(Cycle(O, n));
+      }
+    }
+
+    GENRESULT R = {0, 0};
+    for( auto const& C : Comps ){
+      SSTDebugCounters K = C.Dbg->GetCounters();
+      R.Records += K.Dumps;
+      R.Bytes   += K.Bytes;
+    }
+    return R;
+  }
+
+  /// SSTDebugGen: writes the components of one rank
+  static GENRESULT RunRank(const GENOPTS& O, unsigned Rank, unsigned Ranks){
+    const unsigned Threads = std::max(1u, O.Threads);
+    std::vector<GENRESULT> Results(Threads, GENRESULT{0, 0});
+    std::vector<std::thread> T;
+    for( unsigned t=0; t<Threads; t++ ){
+      T.emplace_back([&,t](){
+        Results[t] = RunThread(O, Rank, Ranks, t, Threads);
+      });
+    }
+    GENRESULT R = {0, 0};
+    for( unsigned t=0; t<Threads; t++ ){
+      T[t].join();
+      R.Records += Results[t].Records;
+      R.Bytes   += Results[t].Bytes;
+    }
+    return R;
+  }
+};
+
+#endif  // #ifndef _SSTDEBUGGEN_H_
+
+// EOF
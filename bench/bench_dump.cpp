@@ -0,0 +1,150 @@
+//
+// bench_dump.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+// Cost of the component side: a single dump() of scalars, strings and
+// containers, a watch snapshot, and the generation of whole run
+// directories of N components x M cycles
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SSTDebug.h"
+#include "SSTDebugBench.h"
+
+int main( int argc, char **argv ){
+  SSTDebugBench B("dump", argc, argv);
+
+  const uint64_t DUMPS = B.Size(20000);
+
+  // -- micro: a single dump() call; every call writes one dump file
+  {
+    std::string Dir = B.ScratchDir("scalar");
+    SSTDebug Dbg("bench_scalar", Dir);
+    uint64_t Cnt = 42;
+    int Credit = -7;
+    double Rate = 0.125;
+    bool Busy = true;
+    auto S = B.Measure([&](){ SSTDebugBench::Clear(Dir); }, [&](){
+      for( uint64_t c=0; c<DUMPS; c++ )
+        Dbg.dump(c, DARG(Cnt), DARG(Credit), DARG(Rate), DARG(Busy));
+    });
+    B.Emit("scalar", {{"keys",4}}, DUMPS, S, SSTDebugBench::DirSize(Dir).second);
+  }
+
+  {
+    std::string Dir = B.ScratchDir("string");
+    SSTDebug Dbg("bench_string", Dir);
+    std::string Src(64, 's');
+    std::string Dst(64, 'd');
+    std::string Op  = "READ";
+    std::string Msg(256, 'm');
+    auto S = B.Measure([&](){ SSTDebugBench::Clear(Dir); }, [&](){
+      for( uint64_t c=0; c<DUMPS; c++ )
+        Dbg.dump(c, DARG(Src), DARG(Dst), DARG(Op), DARG(Msg));
+    });
+    B.Emit("string", {{"keys",4}}, DUMPS, S, SSTDebugBench::DirSize(Dir).second);
+  }
+
+  for( uint64_t Len : {8, 64, 512} ){
+    std::string Dir = B.ScratchDir("array");
+    SSTDebug Dbg("bench_array", Dir);
+    std::vector<uint64_t> Regs(Len);
+    for( uint64_t i=0; i<Len; i++ )
+      Regs[i] = i * 0x9e3779b97f4a7c15ull;
+    auto S = B.Measure([&](){ SSTDebugBench::Clear(Dir); }, [&](){
+      for( uint64_t c=0; c<DUMPS; c++ )
+        Dbg.dump(c, DARG(Regs));
+    });
+    B.Emit("array", {{"elems",Len}}, DUMPS, S, SSTDebugBench::DirSize(Dir).second);
+  }
+
+  {
+    std::string Dir = B.ScratchDir("map");
+    SSTDebug Dbg("bench_map", Dir);
+    std::map<std::string,unsigned> Credits;
+    for( unsigned i=0; i<16; i++ )
+      Credits["port" + std::to_string(i)] = i;
+    auto S = B.Measure([&](){ SSTDebugBench::Clear(Dir); }, [&](){
+      for( uint64_t c=0; c<DUMPS; c++ )
+        Dbg.dump(c, DARG(Credits));
+    });
+    B.Emit("map", {{"elems",16}}, DUMPS, S, SSTDebugBench::DirSize(Dir).second);
+  }
+
+  // -- micro: a snapshot of registered watch variables
+  {
+    std::string Dir = B.ScratchDir("watch");
+    SSTDebug Dbg("bench_watch", Dir);
+    uint64_t Cnt = 42;
+    double Rate = 0.125;
+    uint64_t Regs[64] = {0};
+    Dbg.watch("Cnt", &Cnt);
+    Dbg.watch("Rate", &Rate);
+    Dbg.watch("Regs", &Regs);
+    auto S = B.Measure([&](){ SSTDebugBench::Clear(Dir); }, [&](){
+      for( uint64_t c=0; c<DUMPS; c++ ){
+        Cnt++;
+        Dbg.snapshot(c);
+      }
+    });
+    B.Emit("watch", {{"keys",3},{"elems",66}}, DUMPS, S, SSTDebugBench::DirSize(Dir).second);
+  }
+
+  // -- macro: a run directory of COMPS components x CYCLES cycles,
+  //    written by THREADS simulation threads
+  const std::vector<std::pair<uint64_t,uint64_t>> Shapes = {
+    {B.Size(160), 64}, {B.Size(640), 64}, {B.Size(160), 512}
+  };
+  std::vector<uint64_t> Threads = {1};
+  const uint64_t MaxThreads = std::min(8u, std::thread::hardware_concurrency());
+  if( MaxThreads > 1 )
+    Threads.push_back(MaxThreads);
+  for( auto const& Shape : Shapes ){
+    for( uint64_t THREADS : Threads ){
+      const uint64_t COMPS  = Shape.first;
+      const uint64_t CYCLES = Shape.second;
+      std::string Dir = B.ScratchDir("dir");
+      std::vector<std::unique_ptr<SSTDebug>> Dbg;
+      for( uint64_t i=0; i<COMPS; i++ )
+        Dbg.emplace_back(new SSTDebug("bench_comp" + std::to_string(i), Dir));
+
+      auto S = B.Measure([&](){ SSTDebugBench::Clear(Dir); }, [&](){
+        std::vector<std::thread> T;
+        for( uint64_t t=0; t<THREADS; t++ ){
+          T.emplace_back([&,t](){
+            // each thread clocks its own share of the components
+            for( uint64_t c=0; c<CYCLES; c++ ){
+              for( uint64_t i=t; i<COMPS; i+=THREADS ){
+                uint64_t Cycle = c;
+                uint64_t Id = i;
+                double Util = double(c % 100) / 100.0;
+                unsigned Credits = (unsigned)((i + c) % 32);
+                std::string State = (c & 1) ? "BUSY" : "IDLE";
+                Dbg[i]->dump(c, DARG(Cycle), DARG(Id), DARG(Util),
+                             DARG(Credits), DARG(State));
+              }
+            }
+          });
+        }
+        for( auto& Th : T )
+          Th.join();
+      });
+      auto Size = SSTDebugBench::DirSize(Dir);
+      B.Emit("dirgen", {{"comps",COMPS},{"cycles",CYCLES},{"threads",THREADS}},
+             Size.first, S, Size.second);
+    }
+  }
+
+  return 0;
+}
+
+// EOF
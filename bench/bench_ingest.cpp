@@ -0,0 +1,110 @@
+//
+// bench_ingest.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+// Console ingest rate: dump files parsed serially, through the parser
+// pool, and through the parser pool into the console's store and index
+// (the work of DebugConsole::DumpFileContents without the terminal UI)
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SSTDebug.h"
+#include "SSTDebugBench.h"
+#include "SSTDebugParse.h"
+#include "View/DumpIndex.h"
+#include "View/DumpStore.h"
+
+// submits every file to the pool and waits for their records
+static void Ingest(const std::vector<std::string>& Files,
+                   DumpParserPool::Sink Sink, std::atomic<uint64_t>& Count){
+  Count = 0;
+  {
+    DumpParserPool Pool(Sink);
+    Pool.submit(Files);
+    while( Count.load() < Files.size() )
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
+
+int main( int argc, char **argv ){
+  SSTDebugBench B("ingest", argc, argv);
+
+  const uint64_t CYCLES = 32;
+
+  for( uint64_t COMPS : {B.Size(64), B.Size(512)} ){
+    std::string Dir = B.ScratchDir("dir");
+    for( uint64_t i=0; i<COMPS; i++ ){
+      SSTDebug Dbg("bench_comp" + std::to_string(i), Dir);
+      for( uint64_t c=0; c<CYCLES; c++ ){
+        uint64_t Id = i;
+        double Util = double(c) / CYCLES;
+        unsigned Credits = (unsigned)((i + c) % 32);
+        std::string State = (c & 1) ? "BUSY" : "IDLE";
+        std::vector<unsigned> Queue = {Credits, Credits + 1, Credits + 2};
+        Dbg.dump(c, DARG(Id), DARG(Util), DARG(Credits), DARG(State), DARG(Queue));
+      }
+    }
+
+    std::vector<std::string> Files;
+    for( auto const& E : std::filesystem::directory_iterator(Dir) )
+      Files.push_back(E.path().string());
+    const uint64_t BYTES = SSTDebugBench::DirSize(Dir).second;
+    const BENCHPARAMS P = {{"comps",COMPS},{"cycles",CYCLES},{"files",Files.size()}};
+
+    // serial parse of every file
+    uint64_t Values = 0;
+    auto S = B.Measure([&](){
+      for( auto const& F : Files )
+        Values += parse_dump_file(F).values.size();
+    });
+    B.Emit("parse_file", P, Files.size(), S, BYTES);
+
+    // the parser pool handing its batches to an empty sink
+    std::atomic<uint64_t> Count{0};
+    S = B.Measure([&](){
+      Ingest(Files, [&](std::vector<DumpRecord>&& R){ Count += R.size(); }, Count);
+    });
+    B.Emit("parse_pool", P, Files.size(), S, BYTES);
+
+    // the parser pool feeding the console's store and index
+    std::unique_ptr<DumpStore> Store;
+    std::unique_ptr<DumpIndex> Index;
+    std::mutex Lock;
+    S = B.Measure([&](){
+      Store.reset(new DumpStore());
+      Index.reset(new DumpIndex());
+    }, [&](){
+      Ingest(Files, [&](std::vector<DumpRecord>&& R){
+        {
+          std::lock_guard<std::mutex> lock(Lock);
+          for( auto const& Rec : R ){
+            Store->Add(Rec);
+            Index->Add(Rec);
+          }
+        }
+        Count += R.size();
+      }, Count);
+    });
+    B.Emit("ingest", P, Files.size(), S, BYTES);
+
+    if( Values == 0 ){
+      std::cerr << "no dump values were parsed from " << Dir << std::endl;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,75 @@
+//
+// bench_read.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+// Latency of the SSTDebug readers against the size of the run
+// directory: GetComponents, GetClockVals, GetClockValsByComponent and
+// GetDebugValues
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "SSTDebug.h"
+#include "SSTDebugBench.h"
+
+int main( int argc, char **argv ){
+  SSTDebugBench B("read", argc, argv);
+
+  const uint64_t CYCLES  = 16;
+  const uint64_t LOOKUPS = B.Size(2000);
+
+  for( uint64_t COMPS : {B.Size(64), B.Size(256), B.Size(1024), B.Size(4096)} ){
+    // populate the run directory once; it is only read below
+    std::string Dir = B.ScratchDir("dir");
+    for( uint64_t i=0; i<COMPS; i++ ){
+      SSTDebug Dbg("bench_comp" + std::to_string(i), Dir);
+      for( uint64_t c=0; c<CYCLES; c++ ){
+        uint64_t Id = i;
+        double Util = double(c) / CYCLES;
+        std::string State = (c & 1) ? "BUSY" : "IDLE";
+        Dbg.dump(c, DARG(Id), DARG(Util), DARG(State));
+      }
+    }
+    const uint64_t FILES = SSTDebugBench::DirSize(Dir).first;
+    const BENCHPARAMS P = {{"comps",COMPS},{"cycles",CYCLES},{"files",FILES}};
+
+    SSTDebug Dbg("bench_reader", Dir);
+    size_t Sink = 0;
+
+    auto S = B.Measure([&](){ Sink += Dbg.GetComponents().size(); });
+    B.Emit("GetComponents", P, 1, S);
+
+    S = B.Measure([&](){ Sink += Dbg.GetClockVals().size(); });
+    B.Emit("GetClockVals", P, 1, S);
+
+    S = B.Measure([&](){ Sink += Dbg.GetClockValsByComponent("bench_comp0").size(); });
+    B.Emit("GetClockValsByComponent", P, 1, S);
+
+    // random component/cycle lookups
+    std::mt19937_64 Rng(COMPS);
+    std::vector<std::pair<std::string,uint64_t>> Keys;
+    for( uint64_t k=0; k<LOOKUPS; k++ )
+      Keys.emplace_back("bench_comp" + std::to_string(Rng() % COMPS), Rng() % CYCLES);
+    S = B.Measure([&](){
+      for( auto const& K : Keys )
+        Sink += Dbg.GetDebugValues(K.first, K.second).size();
+    });
+    B.Emit("GetDebugValues", P, LOOKUPS, S);
+
+    if( Sink == 0 ){
+      std::cerr << "no dump values were read from " << Dir << std::endl;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,101 @@
+//
+// bench_scale.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+// Scale test of the readers and the console against synthetic run
+// directories: generation, GetComponents, GetClockVals,
+// GetClockValsByComponent and the console's startup scan.  With --data
+// an existing directory (e.g., written by sstdbg_gen) is measured instead.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SSTDebugGen.h"
+#include "SSTDebugBench.h"
+#include "SSTDebugDir.h"
+
+// times the readers and the console startup against the run directory
+static void MeasureDir( SSTDebugBench& B, const std::string& Dir,
+                        const BENCHPARAMS& P, const std::string& Comp ){
+#ifdef SSTDBG_ASCII
+  const std::string Ext = ".out";
+#else
+  const std::string Ext = ".json";
+#endif
+  SSTDebug Dbg("bench_reader", Dir);
+  size_t Sink = 0;
+
+  auto S = B.Measure([&](){ Sink += Dbg.GetComponents().size(); });
+  B.Emit("GetComponents", P, 1, S);
+
+  S = B.Measure([&](){ Sink += Dbg.GetClockVals().size(); });
+  B.Emit("GetClockVals", P, 1, S);
+
+  S = B.Measure([&](){ Sink += Dbg.GetClockValsByComponent(Comp).size(); });
+  B.Emit("GetClockValsByComponent", P, 1, S);
+
+  // the console has started once its watcher has catalogued the dumps
+  // already in the directory
+  uint64_t Files = 0;
+  std::error_code ec;
+  for( auto const& E : std::filesystem::directory_iterator(Dir, ec) )
+    Files += (E.path().extension() == Ext);
+  S.clear();
+  for( unsigned r=0; r<B.GetReps(); r++ ){
+    std::unique_ptr<DumpDir> Console;
+    auto Start = std::chrono::steady_clock::now();
+    Console.reset(new DumpDir(Dir, Ext));
+    while( Console->get_files().size() < Files )
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::chrono::duration<double> D = std::chrono::steady_clock::now() - Start;
+    S.push_back(D.count());
+  }
+  B.Emit("console_startup", P, 1, S);
+
+  if( Sink == 0 )
+    std::cerr << "no dumps were found in " << Dir << std::endl;
+}
+
+int main( int argc, char **argv ){
+  SSTDebugBench B("scale", argc, argv);
+
+  if( !B.GetData().empty() ){
+    SSTDebug Dbg("bench_reader", B.GetData());
+    std::vector<std::string> Comps = Dbg.GetComponents();
+    MeasureDir(B, B.GetData(), {{"files",SSTDebugBench::DirSize(B.GetData()).first}},
+               Comps.empty() ? "" : Comps.front());
+    return 0;
+  }
+
+  // component and cycle counts are scaled independently; the cliffs of
+  // the full directory scans show as the file count grows
+  const std::vector<std::pair<uint64_t,uint64_t>> Shapes = {
+    {B.Size(128), 32}, {B.Size(512), 32}, {B.Size(2048), 32}, {B.Size(128), 512}
+  };
+  for( auto const& Shape : Shapes ){
+    GENOPTS O = SSTDebugGen::Defaults();
+    O.Dir    = B.ScratchDir("dir");
+    O.Comps  = Shape.first;
+    O.Cycles = Shape.second;
+
+    GENRESULT R = {0, 0};
+    const double Secs = SSTDebugBench::Time([&](){ R = SSTDebugGen::Run(O); });
+    const BENCHPARAMS P = {{"comps",O.Comps},{"cycles",O.Cycles},{"keys",O.Keys},
+                           {"threads",O.Threads},{"files",R.Records}};
+    B.Emit("generate", P, R.Records, {Secs}, R.Bytes);
+
+    MeasureDir(B, O.Dir, P, SSTDebugGen::CompName(0));
+  }
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,115 @@
+//
+// sstdbg_gen.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+// Writes a synthetic run directory for scale testing the readers and
+// the console; see SSTDebugGen.h for the shape of the generated data
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include "SSTDebugGen.h"
+
+#ifdef SSTDBG_ASCII
+#define SSTDBG_GEN_FORMAT "ascii"
+#else
+#define SSTDBG_GEN_FORMAT "json"
+#endif
+
+static void Usage( const char *Exe ){
+  std::cerr << "usage: " << Exe << " [options] DIR" << std::endl
+            << "  -c|--comps N     components (default 64)" << std::endl
+            << "  -n|--cycles N    dumps per component (default 16)" << std::endl
+            << "  -i|--interval N  simulated cycles between dumps (default 1000)" << std::endl
+            << "  -k|--keys N      values per record (default 8)" << std::endl
+            << "  -e|--entropy E   fraction of the values changing between dumps (default 0.5)" << std::endl
+            << "  -r|--ranks N     writer processes (default 1; MPI builds use the MPI ranks)" << std::endl
+            << "  -t|--threads N   writer threads per rank" << std::endl
+            << "  -s|--seed N      random seed (default 1)" << std::endl
+            << "  -f|--format F    output format; this build writes " << SSTDBG_GEN_FORMAT << std::endl;
+}
+
+int main( int argc, char **argv ){
+  GENOPTS O = SSTDebugGen::Defaults();
+  std::string Dir;
+
+  for( int i=1; i<argc; i++ ){
+    std::string Arg(argv[i]);
+    const bool HasVal = (i+1 < argc);
+    if( ((Arg == "-c") || (Arg == "--comps")) && HasVal ){
+      O.Comps = std::strtoull(argv[++i], nullptr, 10);
+    }else if( ((Arg == "-n") || (Arg == "--cycles")) && HasVal ){
+      O.Cycles = std::strtoull(argv[++i], nullptr, 10);
+    }else if( ((Arg == "-i") || (Arg == "--interval")) && HasVal ){
+      O.Interval = std::max<uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+    }else if( ((Arg == "-k") || (Arg == "--keys")) && HasVal ){
+      O.Keys = (unsigned)(std::strtoul(argv[++i], nullptr, 10));
+    }else if( ((Arg == "-e") || (Arg == "--entropy")) && HasVal ){
+      O.Entropy = std::strtod(argv[++i], nullptr);
+    }else if( ((Arg == "-r") || (Arg == "--ranks")) && HasVal ){
+      O.Ranks = std::max(1u, (unsigned)(std::strtoul(argv[++i], nullptr, 10)));
+    }else if( ((Arg == "-t") || (Arg == "--threads")) && HasVal ){
+      O.Threads = std::max(1u, (unsigned)(std::strtoul(argv[++i], nullptr, 10)));
+    }else if( ((Arg == "-s") || (Arg == "--seed")) && HasVal ){
+      O.Seed = std::strtoull(argv[++i], nullptr, 10);
+    }else if( ((Arg == "-f") || (Arg == "--format")) && HasVal ){
+      // the dump format is selected when SSTDebug is compiled
+      std::string F(argv[++i]);
+      if( F != SSTDBG_GEN_FORMAT ){
+        std::cerr << "this build writes " << SSTDBG_GEN_FORMAT
+                  << " dumps; use sstdbg_gen_" << F << std::endl;
+        return -1;
+      }
+    }else if( (Arg[0] != '-') && Dir.empty() ){
+      Dir = Arg;
+    }else{
+      Usage(argv[0]);
+      return -1;
+    }
+  }
+
+  if( Dir.empty() ){
+    Usage(argv[0]);
+    return -1;
+  }
+  mkdir(Dir.c_str(), 0777);
+  O.Dir = Dir;
+
+#ifdef SSTDBG_MPI
+  MPI_Init(&argc, &argv);
+  int Rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &Rank);
+#else
+  const int Rank = 0;
+#endif
+
+  auto Start = std::chrono::steady_clock::now();
+  GENRESULT R = SSTDebugGen::Run(O);
+  std::chrono::duration<double> Secs = std::chrono::steady_clock::now() - Start;
+
+  // one summary line, in the format of the benchmark results
+  if( Rank == 0 ){
+    std::cout << "{\"dir\":\"" << Dir << "\",\"format\":\"" << SSTDBG_GEN_FORMAT
+              << "\",\"comps\":" << O.Comps << ",\"cycles\":" << O.Cycles
+              << ",\"keys\":" << O.Keys << ",\"entropy\":" << O.Entropy
+              << ",\"records\":" << R.Records << ",\"bytes\":" << R.Bytes
+              << ",\"secs\":" << Secs.count()
+              << ",\"records_per_sec\":" << (Secs.count() > 0 ? R.Records / Secs.count() : 0.0)
+              << "}" << std::endl;
+  }
+
+#ifdef SSTDBG_MPI
+  MPI_Finalize();
+#endif
+  return (R.Records == O.Comps * O.Cycles) ? 0 : -1;
+}
+
+// EOF
@@ -10,8 +10,10 @@
 
 // #include "SSTDebug.h"
 #include "SSTDebugDir.h"
+#include "SSTDebugShm.h"
 #include "View/DebugConsole.h"
 #include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 #include <nlohmann/json.hpp>
 #include <signal.h>
@@ -23,10 +25,6 @@ using json = nlohmann::json;
 constexpr float UpdateInterval = 1.0f / 20.0f;
 constexpr float PingInterval = 1.0f;
 
-void Wait(float seconds) {
-  this_thread::sleep_for(chrono::milliseconds(int(seconds * 1000.0f)));
-}
-
 int main(int argc, char *argv[]) {
   // ===============
   // SST Specific
@@ -58,43 +56,55 @@ int main(int argc, char *argv[]) {
 
   view.Init();
 
+  // dump files are parsed off the UI thread; each worker appends its
+  // finished records to the console in one batch
+  DumpParserPool Parsers([&view](std::vector<DumpRecord> &&Records) {
+    view.OnDumpRecords(std::move(Records));
+  });
+
+  // SSTDBG_SHM=/name: consume the records SSTDebug publishes to the shared
+  // memory ring; no dump files are involved unless the tee is enabled
+  std::unique_ptr<DumpRingReader> Ring;
+  if (const char *Shm = std::getenv("SSTDBG_SHM")) {
+    uint64_t MB = 64;
+    if (const char *Size = std::getenv("SSTDBG_SHM_MB")) {
+      MB = std::strtoull(Size, nullptr, 10);
+    }
+    Ring.reset(new DumpRingReader(Shm, MB << 20,
+                                  [&view](std::vector<DumpRecord> &&Records) {
+                                    view.OnDumpRecords(std::move(Records));
+                                  }));
+    if (Ring->is_open()) {
+      view.OnLog({"$y[SSTDebug] Reading dumps from shared memory ring " +
+                  std::string(Shm)});
+    } else {
+      view.OnLog({"$r[SSTDebug] Unable to open shared memory ring " +
+                  std::string(Shm)});
+    }
+  }
+
   bool sst_running = false;
-  float directory_scan_interval = 2.0f;
 
   view.OnLog({"$y[SSTDebug] Searching for existing sst-process..."});
   view.OnLog({"$y[SSTDebug] None found... Type `(run|r) -- <sst-args> to start "
               "a debug process"});
 
-  const std::vector<std::string> &DumpsToProcess =
-      DumpDirectory->get_unprocessed_files();
-  // view.OnLog({"Files found:"});
-  // for (auto dumpfile : DumpsToProcess)
-  //   view.OnLog({dumpfile});
-
-  // Capture time program is launched to distinguish NEW dump files vs
-  // pre-existing. Not sure if this is the best way but it seems to work
-  std::filesystem::file_time_type ProgramLaunchTime =
-      std::filesystem::file_time_type::clock::now();
+  // Dump files present before the console started are not reported;
+  // the watcher thread queues every dump that appears afterwards
+  std::vector<std::string> NewDumps;
 
   // view.SetSSTPath(view.FindSST());
 
   while (view.OnUpdate(UpdateInterval)) {
-    Wait(UpdateInterval);
-
-    if (DumpsToProcess.size() > 0) {
-
-      // process files
-      for (unsigned i = 0; i < DumpsToProcess.size(); i++) {
-        if (std::filesystem::last_write_time(DumpsToProcess.at(i)) >
-            ProgramLaunchTime) {
-          view.OnLog({"$b[SSTDebug] New Dump Found: " + DumpsToProcess.at(i)});
-          view.DumpFileContents(DumpsToProcess.at(i));
-          std::string FileToDump =
-              DumpDirectory->ProcessFile(DumpsToProcess.at(i));
-        }
-      }
-      directory_scan_interval -= UpdateInterval;
+    // sleep until the next UI tick or until new dumps arrive
+    NewDumps.clear();
+    if (!DumpDirectory->pop_new_files(
+            NewDumps, chrono::milliseconds(int(UpdateInterval * 1000.0f)))) {
+      continue;
     }
+
+    // hand the files to the parser pool
+    Parsers.submit(NewDumps);
   }
 
   view.Shutdown();
@@ -11,10 +11,58 @@
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
-#include <set>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_set>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <unordered_map>
+
+#include "SSTDebugRetain.h"
+
+// DumpQueue: multi-producer queue of new dump files
+// Producers append under the lock; the consumer swaps out the whole
+// batch at once so each file costs O(1) to hand over
+class DumpQueue {
+public:
+    void push(const std::vector<std::string>& files) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.insert(m_queue.end(), files.begin(), files.end());
+        }
+        m_cv.notify_one();
+    }
+
+    // Pops every queued file into `files`; waits up to `timeout` for the
+    // first one.  Returns false if nothing was popped.
+    bool pop_batch(std::vector<std::string>& files,
+                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_queue.empty() && timeout.count() > 0) {
+            m_cv.wait_for(lock, timeout, [this] { return !m_queue.empty(); });
+        }
+        if (m_queue.empty()) {
+            return false;
+        }
+        if (files.empty()) {
+            files.swap(m_queue);
+        } else {
+            files.insert(files.end(), m_queue.begin(), m_queue.end());
+            m_queue.clear();
+        }
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::string> m_queue;
+};
 
 class DumpDir {
 public:
@@ -37,54 +85,138 @@ public:
             std::cout << file << std::endl;
         }
     }
-    std::string ProcessFile(std::string Filename){
-      std::lock_guard<std::mutex> lock(m_unprocessed_files_mutex);
-      m_unprocessed_files.erase(std::remove(m_unprocessed_files.begin(),
-                                            m_unprocessed_files.end(),
-                                            Filename), m_unprocessed_files.end());
-      return Filename;
-    }
 
-    const std::vector<std::string>& get_files() {
+    std::vector<std::string> get_files() {
         std::lock_guard<std::mutex> lock(m_files_mutex);
         return m_files;
     }
 
-    const std::vector<std::string>& get_unprocessed_files() {
-      std::lock_guard<std::mutex> lock(m_unprocessed_files_mutex);
-      return m_unprocessed_files;
+    // Pops the dump files that appeared after the watcher started;
+    // waits up to `timeout` for the first one
+    bool pop_new_files(std::vector<std::string>& files,
+                       std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        return m_new_files.pop_batch(files, timeout);
     }
 
+    // Is the directory being watched with inotify (vs. polled)?
+    bool is_watching() const { return m_watching; }
+
 private:
     void update_files() {
-        std::set<std::filesystem::path> previous_files;
-        while (m_running) {
-            std::set<std::filesystem::path> current_files;
+        // prefer kernel notifications; fall back to polling the directory
+        // when inotify is unavailable (e.g., some network filesystems)
+        if (!watch_files()) {
+            poll_files();
+        }
+    }
 
-            for (const auto& entry : std::filesystem::directory_iterator(m_dir)) {
-                if (entry.path().extension() == m_file_type) {
-                    current_files.insert(entry.path());
+    // Records the files that have not been seen before; files found by
+    // the initial scan pre-date the watcher and are not queued as new.
+    // Shard files are queued again each time records are appended.
+    void add_files(const std::vector<std::string>& files, bool initial = false) {
+        std::vector<std::string> new_files;
+        std::vector<std::string> queued;
+        for (const auto& file : files) {
+            bool fresh = m_seen.insert(file).second;
+            if (fresh) {
+                new_files.push_back(file);
+            }
+            if (fresh || IsShardFile(file)) {
+                queued.push_back(file);
+            }
+        }
+
+        // new files found
+        if (!new_files.empty()) {
+            std::lock_guard<std::mutex> lock(m_files_mutex);
+            m_files.insert(m_files.end(), new_files.begin(), new_files.end());
+        }
+        if (!initial && !queued.empty()) {
+            m_new_files.push(queued);
+        }
+    }
+
+    void scan_files(bool initial = false) {
+        std::vector<std::string> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(m_dir, ec)) {
+            if (entry.path().extension() != m_file_type) {
+                continue;
+            }
+            // shards are only reported again once they have grown
+            if (IsShardFile(entry.path())) {
+                auto size = entry.file_size(ec);
+                auto& last = m_shard_sizes[entry.path().string()];
+                if (!initial && (size == last)) {
+                    continue;
                 }
+                last = size;
+            }
+            files.push_back(entry.path().string());
+        }
+        add_files(files, initial);
+    }
+
+    bool watch_files() {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd == -1) {
+            return false;
+        }
+
+        // only report files once they have been written and closed
+        int wd = inotify_add_watch(fd, m_dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd == -1) {
+            close(fd);
+            return false;
+        }
+        m_watching = true;
+
+        // the watch is armed before the initial scan so no file is missed
+        scan_files(true);
+
+        alignas(struct inotify_event) char buffer[16384];
+        struct pollfd pfd = {fd, POLLIN, 0};
+        while (m_running) {
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
             }
 
-            std::vector<std::string> new_files;
-            for (const auto& file : current_files) {
-                if (previous_files.find(file) == previous_files.end()) {
-                    new_files.push_back(file.string());
+            std::vector<std::string> files;
+            bool overflow = false;
+            ssize_t len;
+            while ((len = read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + len;) {
+                    auto* event = reinterpret_cast<struct inotify_event*>(p);
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        overflow = true;
+                    } else if ((event->len > 0) && !(event->mask & IN_ISDIR)) {
+                        std::filesystem::path file =
+                            std::filesystem::path(m_dir) / event->name;
+                        if (file.extension() == m_file_type) {
+                            files.push_back(file.string());
+                        }
+                    }
+                    p += sizeof(struct inotify_event) + event->len;
                 }
             }
+            add_files(files);
 
-            // new files found
-            if (!new_files.empty()) {
-                std::lock_guard<std::mutex> lock(m_files_mutex);
-                m_files.insert(m_files.end(), new_files.begin(), new_files.end());
-                m_unprocessed_files.insert(m_unprocessed_files.end(),
-                                           new_files.begin(),
-                                           new_files.end());
+            // the kernel dropped events; recover with a full scan
+            if (overflow) {
+                scan_files();
             }
+        }
 
-            previous_files = current_files;
+        inotify_rm_watch(fd, wd);
+        close(fd);
+        return true;
+    }
+
+    void poll_files() {
+        scan_files(true);
+        while (m_running) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
+            scan_files();
         }
     }
 
@@ -92,10 +224,11 @@ private:
     std::string m_dir;
     std::string m_file_type;
     std::vector<std::string> m_files;
-    std::vector<std::string> m_unprocessed_files;
-    bool m_new_files_found;
+    std::unordered_set<std::string> m_seen;
+    std::unordered_map<std::string, uintmax_t> m_shard_sizes;
     std::thread m_update_thread;
-    bool m_running;
-    std::mutex m_unprocessed_files_mutex;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_watching{false};
+    DumpQueue m_new_files;
     std::mutex m_files_mutex;
 };
@@ -0,0 +1,367 @@
+//
+// _SSTDebugParse_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "SSTDebugRetain.h"
+
+// DumpRecord: the parsed contents of a single dump file
+struct DumpRecord {
+    std::string file;
+    std::string component;
+    uint64_t cycle = 0;
+    bool valid = false;
+    std::string error;
+    std::vector<std::pair<std::string, std::string>> values;
+};
+
+// Appends the values of a nested scope object as scope/key names
+inline void flatten_dump_json(const std::string& prefix, const nlohmann::json& j,
+                              DumpRecord& record) {
+    for (auto it = j.begin(); it != j.end(); ++it) {
+        if (it.value().is_object()) {
+            flatten_dump_json(prefix + it.key() + "/", it.value(), record);
+        } else {
+            record.values.emplace_back(prefix + it.key(), it.value().is_string()
+                                                              ? it.value().get<std::string>()
+                                                              : it.value().dump());
+        }
+    }
+}
+
+// Parses the body of a JSON dump record.  On a syntax error, `error_byte`
+// (if given) receives the 1-based offset of the error from the record start.
+inline bool parse_dump_json(std::istream& input, DumpRecord& record,
+                            uint64_t* error_byte = nullptr) {
+    nlohmann::json j;
+    try {
+        input >> j;
+    } catch (const nlohmann::json::parse_error& e) {
+        record.error = e.what();
+        if (error_byte) {
+            *error_byte = e.byte;
+        }
+        return false;
+    } catch (const nlohmann::json::exception& e) {
+        record.error = e.what();
+        return false;
+    }
+    if (!j.is_object()) {
+        record.error = "dump record is not a JSON object";
+        return false;
+    }
+    for (auto it = j.begin(); it != j.end(); ++it) {
+        if (it.value().is_object()) {
+            flatten_dump_json(it.key() + "/", it.value(), record);
+            continue;
+        }
+        std::string value =
+            it.value().is_string() ? it.value().get<std::string>() : it.value().dump();
+        if (it.key() == "Element") {
+            record.component = value;
+        } else if (it.key() == "Cycle" && it.value().is_number_unsigned()) {
+            record.cycle = it.value().get<uint64_t>();
+        } else {
+            record.values.emplace_back(it.key(), std::move(value));
+        }
+    }
+    return true;
+}
+
+// Header line introducing each ASCII record of a shared (MPI) file
+inline const std::string& ascii_element_key() {
+    static const std::string key = "#Element,";
+    return key;
+}
+
+// Parses the body of an ASCII dump record; one `key,value` pair per line.
+// The `#Element,Component` header of a record from a shared file is skipped.
+inline bool parse_dump_ascii(std::istream& input, DumpRecord& record) {
+    const std::string& key = ascii_element_key();
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            continue;
+        }
+        auto pos = line.find(',');
+        if (pos == std::string::npos) {
+            record.values.emplace_back(line, "");
+        } else {
+            record.values.emplace_back(line.substr(0, pos), line.substr(pos + 1));
+        }
+    }
+    return true;
+}
+
+// Parses a JSON (Component.Cycle.json) or ASCII (Component.Cycle.out)
+// dump file.  Never throws; a malformed file yields an invalid record.
+inline DumpRecord parse_dump_file(const std::string& file) {
+    DumpRecord record;
+    record.file = file;
+    ParseDumpName(file, record.component, record.cycle);
+
+    std::ifstream input(file, std::ifstream::in);
+    if (!input.is_open()) {
+        record.error = "unable to open file";
+        return record;
+    }
+
+    if (std::filesystem::path(file).extension() == ".json") {
+        record.valid = parse_dump_json(input, record);
+    } else {
+        record.valid = parse_dump_ascii(input, record);
+    }
+    return record;
+}
+
+// Parses the records appended to a per-thread shard file (SSTDbg.RANK.tN.CYCLE)
+// from `offset` onwards.  A shard holds consecutive records of several
+// components; JSON records carry their Element, ASCII records start with an
+// `#Element,Component` line.  Only complete records are consumed, so a record
+// still being appended is read on the next call; a malformed JSON record
+// yields an invalid record and parsing resumes at the next line holding `{`.
+// Returns the new offset.
+inline uint64_t parse_dump_shard(const std::string& file, uint64_t offset,
+                                 std::vector<DumpRecord>& records) {
+    std::ifstream input(file, std::ifstream::in | std::ifstream::binary);
+    if (!input.is_open()) {
+        return offset;
+    }
+    input.seekg(offset);
+    std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    DumpRecord base;
+    base.file = file;
+    std::string shard;
+    ParseDumpName(file, shard, base.cycle);
+
+    if (std::filesystem::path(file).extension() == ".json") {
+        std::istringstream in(text);
+        uint64_t consumed = 0;
+        while (true) {
+            in >> std::ws;
+            if (in.peek() == std::char_traits<char>::eof()) {
+                consumed = text.size();
+                break;
+            }
+            DumpRecord record = base;
+            uint64_t start = uint64_t(in.tellg());
+            uint64_t error_byte = 0;
+            if (parse_dump_json(in, record, &error_byte)) {
+                record.valid = true;
+                records.push_back(std::move(record));
+                continue;
+            }
+            if (start + error_byte > text.size()) {
+                // ran out of input: incomplete, retried once the writer has finished
+                consumed = start;
+                break;
+            }
+            // malformed: reported, then resume at the next record's opening brace
+            records.push_back(std::move(record));
+            auto next = text.find("\n{", start);
+            while (next != std::string::npos && next + 2 < text.size() &&
+                   text[next + 2] != '\n') {
+                next = text.find("\n{", next + 1);
+            }
+            if (next == std::string::npos) {
+                consumed = text.size();
+                break;
+            }
+            in.clear();
+            in.seekg(next + 1);
+        }
+        return offset + consumed;
+    }
+
+    // ASCII: consume whole lines; each `#Element` line starts a record
+    auto end = text.rfind('\n');
+    if (end == std::string::npos) {
+        return offset;
+    }
+    const std::string& key = ascii_element_key();
+    std::string component;
+    if ((offset > 0) && (text.compare(0, key.size(), key) != 0)) {
+        // the rest of a record whose first lines were read by the last call
+        std::ifstream head(file, std::ifstream::in | std::ifstream::binary);
+        std::string prior(offset, '\0');
+        head.read(&prior[0], std::streamsize(offset));
+        auto pos = prior.rfind("\n" + key);
+        pos = (pos == std::string::npos) ? 0 : pos + 1;
+        if (prior.compare(pos, key.size(), key) == 0) {
+            component = prior.substr(pos + key.size(),
+                                     prior.find('\n', pos) - pos - key.size());
+        }
+    }
+    std::istringstream in(text.substr(0, end + 1));
+    std::string line;
+    bool open = false;
+    while (std::getline(in, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            component = line.substr(key.size());
+            open = false;
+            continue;
+        }
+        auto comma = line.find(',');
+        if ((comma == std::string::npos) || component.empty()) {
+            continue;
+        }
+        if (!open) {
+            records.push_back(base);
+            records.back().component = component;
+            records.back().valid = true;
+            open = true;
+        }
+        records.back().values.emplace_back(line.substr(0, comma), line.substr(comma + 1));
+    }
+    return offset + end + 1;
+}
+
+// Parses a dump record received in memory (e.g., from the shared memory
+// ring); JSON records are recognized by their opening brace
+inline DumpRecord parse_dump_text(const std::string& source, const std::string& component,
+                                  uint64_t cycle, const std::string& text) {
+    DumpRecord record;
+    record.file = source;
+    record.component = component;
+    record.cycle = cycle;
+
+    std::istringstream input(text);
+    if (!text.empty() && text[0] == '{') {
+        record.valid = parse_dump_json(input, record);
+    } else {
+        record.valid = parse_dump_ascii(input, record);
+    }
+    return record;
+}
+
+// DumpParserPool: parses dump files on a pool of worker threads
+//
+// Each worker takes a chunk of queued files, parses them and hands the
+// finished records to the sink in one call, so the consumer takes its
+// lock once per chunk rather than once per value.
+class DumpParserPool {
+public:
+    using Sink = std::function<void(std::vector<DumpRecord>&&)>;
+
+    explicit DumpParserPool(Sink sink, unsigned threads = 0) : m_sink(std::move(sink)) {
+        if (threads == 0) {
+            threads = std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            m_workers.emplace_back(&DumpParserPool::worker, this);
+        }
+    }
+
+    ~DumpParserPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_cv.notify_all();
+        for (auto& t : m_workers) {
+            t.join();
+        }
+    }
+
+    void submit(const std::vector<std::string>& files) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.insert(m_queue.end(), files.begin(), files.end());
+        }
+        m_cv.notify_all();
+    }
+
+    // Number of files queued but not yet taken by a worker
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size();
+    }
+
+private:
+    static constexpr size_t ChunkSize = 32;   // files parsed per hand-off
+
+    void worker() {
+        std::vector<std::string> files;
+        std::vector<DumpRecord> records;
+        while (true) {
+            files.clear();
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return !m_running || !m_queue.empty(); });
+                if (!m_running) {
+                    return;
+                }
+                size_t n = std::min(ChunkSize, m_queue.size());
+                files.assign(m_queue.begin(), m_queue.begin() + n);
+                m_queue.erase(m_queue.begin(), m_queue.begin() + n);
+            }
+
+            records.clear();
+            records.reserve(files.size());
+            for (const auto& file : files) {
+                if (IsShardFile(file)) {
+                    parse_shard(file, records);
+                } else {
+                    records.push_back(parse_dump_file(file));
+                }
+            }
+            if (!records.empty()) {
+                m_sink(std::move(records));
+            }
+        }
+    }
+
+    // Shards are queued again whenever they grow; each remembers how far
+    // it has been read and is parsed by one worker at a time
+    struct ShardState {
+        std::mutex mutex;
+        uint64_t offset = 0;
+    };
+
+    void parse_shard(const std::string& file, std::vector<DumpRecord>& records) {
+        std::shared_ptr<ShardState> shard;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto& state = m_shards[file];
+            if (!state) {
+                state = std::make_shared<ShardState>();
+            }
+            shard = state;
+        }
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->offset = parse_dump_shard(file, shard->offset, records);
+    }
+
+    Sink m_sink;
+    std::unordered_map<std::string, std::shared_ptr<ShardState>> m_shards;
+    std::vector<std::thread> m_workers;
+    std::deque<std::string> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_running{true};
+};
@@ -0,0 +1,89 @@
+//
+// _SSTDebugProc_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGPROC_H_
+#define _SSTDEBUGPROC_H_
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/types.h>
+
+// ProcSample: a single sample of the /proc/<pid>/stat counters
+typedef struct{
+  bool valid;         // was the sample successfully read?
+  uint64_t utime;     // user time in clock ticks
+  uint64_t stime;     // system time in clock ticks
+}PROCSAMPLE;
+
+/// ReadProcStat: reads the CPU counters of the target process
+/// The comm field may contain spaces, so the remaining fields are
+/// tokenized from the last ')' in the record
+inline bool ReadProcStat(pid_t pid, PROCSAMPLE &S){
+  S.valid = false;
+  S.utime = 0;
+  S.stime = 0;
+
+  std::ifstream Input("/proc/" + std::to_string(pid) + "/stat");
+  if( !Input.is_open() )
+    return false;
+
+  std::string line;
+  std::getline(Input,line);
+  auto pos = line.rfind(')');
+  if( pos == std::string::npos )
+    return false;
+
+  // fields following the comm: state(3) ... utime(14) stime(15)
+  std::istringstream ss(line.substr(pos+1));
+  std::vector<std::string> Fields;
+  std::string tok;
+  while( (Fields.size() < 13) && (ss >> tok) ){
+    Fields.push_back(tok);
+  }
+  if( Fields.size() < 13 )
+    return false;
+
+  S.utime = std::stoull(Fields[11]);
+  S.stime = std::stoull(Fields[12]);
+  S.valid = true;
+  return true;
+}
+
+/// ReadProcRSS: reads the resident set size (in kB) of the target process
+inline bool ReadProcRSS(pid_t pid, uint64_t &RSS){
+  std::ifstream Input("/proc/" + std::to_string(pid) + "/status");
+  if( !Input.is_open() )
+    return false;
+
+  std::string line;
+  while( std::getline(Input,line) ){
+    if( line.compare(0,6,"VmRSS:") == 0 ){
+      RSS = std::stoull(line.substr(6));
+      return true;
+    }
+  }
+  return false;
+}
+
+/// ProcCPUSeconds: converts the sampled clock ticks to seconds
+inline double ProcCPUSeconds(const PROCSAMPLE &S){
+  static const long Ticks = sysconf(_SC_CLK_TCK);
+  if( !S.valid || (Ticks <= 0) )
+    return 0.;
+  return (double)(S.utime + S.stime) / (double)(Ticks);
+}
+
+#endif  // #ifndef _SSTDEBUGPROC_H_
+
+// EOF
@@ -0,0 +1,181 @@
+//
+// _SSTDebugRetain_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGRETAIN_H_
+#define _SSTDEBUGRETAIN_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/// ParseDumpName: splits a dump file name of the form Component.Cycle.(json|out)
+inline bool ParseDumpName(const std::filesystem::path& File,
+                          std::string& Component, uint64_t& Cycle){
+  const auto Ext = File.extension();
+  if( (Ext != ".json") && (Ext != ".out") )
+    return false;
+
+  std::string Stem = File.stem().string();
+  auto pos = Stem.rfind('.');
+  if( (pos == std::string::npos) || (pos == 0) || (pos+1 == Stem.size()) )
+    return false;
+
+  std::string C = Stem.substr(pos+1);
+  if( !std::all_of(C.begin(), C.end(), ::isdigit) )
+    return false;
+
+  Component = Stem.substr(0,pos);
+  Cycle = std::stoull(C);
+  return true;
+}
+
+/// IsShardFile: is this a per-thread shard (SSTDbg.RANK.tN.CYCLE) shared by
+/// the components of an MPI rank?  Shards grow as records are appended.
+inline bool IsShardFile(const std::filesystem::path& File){
+  return File.filename().string().compare(0, 7, "SSTDbg.") == 0;
+}
+
+// DumpRetention: bounds the on-disk footprint of the dump directory
+//
+// A background thread running at idle CPU and I/O priority periodically
+// scans the dump directory and removes the oldest dump files of each
+// component such that at most `Sweeps` cycles and at most `Bytes` bytes
+// remain per component.  The newest dump of a component is never removed.
+class DumpRetention {
+public:
+  DumpRetention(const std::string& Dir, unsigned Sweeps, uint64_t Bytes)
+    : m_dir(Dir), m_sweeps(Sweeps), m_bytes(Bytes) {
+  }
+
+  ~DumpRetention(){ Stop(); }
+
+  /// Is a retention policy configured?
+  bool Enabled() const { return (m_sweeps > 0) || (m_bytes > 0); }
+
+  void Start(){
+    if( !Enabled() || m_thread.joinable() )
+      return;
+    m_running = true;
+    m_thread = std::thread(&DumpRetention::Run, this);
+  }
+
+  void Stop(){
+    m_running = false;
+    if( m_thread.joinable() )
+      m_thread.join();
+  }
+
+  /// Number of files removed so far
+  uint64_t Removed() const { return m_removed; }
+
+  /// Number of bytes reclaimed so far
+  uint64_t Reclaimed() const { return m_reclaimed; }
+
+private:
+  static constexpr unsigned ScanInterval = 1000;  // milliseconds between passes
+  static constexpr unsigned RemoveBatch  = 64;    // files removed before yielding
+
+  typedef struct{
+    uint64_t Cycle;
+    uintmax_t Size;
+    std::filesystem::path Path;
+  }DUMPFILE;
+
+  void LowerPriority(){
+    // best effort: idle cpu scheduling and idle i/o class for this thread
+    struct sched_param Param;
+    Param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &Param);
+#ifdef SYS_ioprio_set
+    const int IOPRIO_WHO_PROCESS = 1;
+    const int IOPRIO_CLASS_IDLE  = 3;
+    const int IOPRIO_CLASS_SHIFT = 13;
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, (int)syscall(SYS_gettid),
+            IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+#endif
+  }
+
+  void Run(){
+    LowerPriority();
+    while( m_running ){
+      Pass();
+      for( unsigned i=0; m_running && (i<ScanInterval/50); i++ ){
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+    }
+    // final pass so the directory is left within the policy
+    Pass();
+  }
+
+  void Pass(){
+    std::unordered_map<std::string,std::vector<DUMPFILE>> Comps;
+    std::error_code ec;
+    for( const auto& entry : std::filesystem::directory_iterator(m_dir, ec) ){
+      std::string Comp;
+      uint64_t Cycle;
+      if( !ParseDumpName(entry.path(), Comp, Cycle) )
+        continue;
+      std::error_code sec;
+      uintmax_t Size = entry.file_size(sec);
+      if( sec )
+        continue;
+      Comps[Comp].push_back({Cycle, Size, entry.path()});
+    }
+
+    unsigned Batch = 0;
+    for( auto& C : Comps ){
+      auto& Files = C.second;
+      // newest first
+      std::sort(Files.begin(), Files.end(),
+                [](const DUMPFILE& a, const DUMPFILE& b){ return a.Cycle > b.Cycle; });
+
+      uintmax_t Total = 0;
+      for( unsigned i=0; i<Files.size(); i++ ){
+        Total += Files[i].Size;
+        if( i == 0 )
+          continue;
+        if( ((m_sweeps > 0) && (i >= m_sweeps)) ||
+            ((m_bytes > 0) && (Total > m_bytes)) ){
+          std::error_code rec;
+          if( std::filesystem::remove(Files[i].Path, rec) ){
+            m_removed++;
+            m_reclaimed += Files[i].Size;
+          }
+          if( ++Batch == RemoveBatch ){
+            Batch = 0;
+            std::this_thread::yield();
+          }
+        }
+      }
+    }
+  }
+
+  std::string m_dir;
+  unsigned m_sweeps;
+  uint64_t m_bytes;
+  std::thread m_thread;
+  std::atomic<bool> m_running{false};
+  std::atomic<uint64_t> m_removed{0};
+  std::atomic<uint64_t> m_reclaimed{0};
+};
+
+#endif  // #ifndef _SSTDEBUGRETAIN_H_
+
+// EOF
@@ -0,0 +1,87 @@
+//
+// _SSTDebugShm_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SSTDebugParse.h"
+#include "SSTDebugRing.h"
+
+// DumpRingReader: consumes dump records from the SSTDebug shared memory
+// ring (SSTDBG_SHM) and hands them to the sink in batches
+//
+// The reader polls the ring with a short, growing back-off so a record
+// reaches the sink within microseconds while the console is otherwise
+// idle.  The ring is created if no producer has done so yet; the reader
+// attaches as its consumer and removes the name when it closes.
+class DumpRingReader {
+public:
+    using Sink = DumpParserPool::Sink;
+
+    DumpRingReader(const std::string& name, uint64_t bytes, Sink sink)
+        : m_name(name), m_sink(std::move(sink)) {
+        if (m_ring.Open(name, bytes)) {
+            m_ring.Attach();
+            m_running = true;
+            m_thread = std::thread(&DumpRingReader::reader, this);
+        }
+    }
+
+    ~DumpRingReader() {
+        m_running = false;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_ring.Unlink();
+    }
+
+    bool is_open() const { return m_ring.IsOpen(); }
+
+    // Records the producers dropped because the ring was full
+    uint64_t dropped() const { return m_ring.Dropped(); }
+
+private:
+    static constexpr size_t BatchSize = 256;   // records per hand-off
+    static constexpr unsigned MinBackoff = 20; // microseconds
+    static constexpr unsigned MaxBackoff = 1000;
+
+    void reader() {
+        SSTDebugRing::RECORD rec;
+        std::vector<DumpRecord> batch;
+        unsigned backoff = MinBackoff;
+        while (m_running) {
+            while (batch.size() < BatchSize && m_ring.Read(rec)) {
+                batch.push_back(parse_dump_text(
+                    "shm:" + rec.Name + "." + std::to_string(rec.Cycle), rec.Name,
+                    rec.Cycle, rec.Text));
+            }
+            if (!batch.empty()) {
+                m_sink(std::move(batch));
+                batch.clear();
+                backoff = MinBackoff;
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(backoff));
+            backoff = std::min(MaxBackoff, backoff * 2);
+        }
+    }
+
+    std::string m_name;
+    Sink m_sink;
+    SSTDebugRing m_ring;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+};
@@ -0,0 +1,318 @@
+//
+// _SSTDebugSock_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGSOCK_H_
+#define _SSTDEBUGSOCK_H_
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Live attach protocol between sst-dbg and the console
+//
+// The launcher listens on a Unix domain stream socket; every message is a
+// single newline terminated line.
+//
+//   launcher -> console
+//     HELLO <pid> <interval>   sent once on connect
+//     OUT <text>               a line of the SST child's stdout
+//     DUMP <n> <reason>        a dump was triggered
+//     DONE <n> <files> <bytes> <secs>
+//                              dump <n> completed: files created, bytes
+//                              written and seconds from trigger to last write
+//     STATUS <pid> <dumps> <interval> <running|paused>
+//     OK <command>             the command was applied
+//     ERR <message>            the command was rejected
+//     EXIT <status>            the SST child exited; the launcher closes
+//
+//   console -> launcher
+//     dump                     trigger a dump now
+//     pause | resume           stop / continue the SST child
+//     interval <sec>           change the timed dump interval (0 = off)
+//     status                   request a STATUS line
+//     detach                   close this connection; the job continues
+
+/// SockAddr: fills a Unix domain address; returns false if the path is too long
+inline bool SockAddr(const std::string& Path, struct sockaddr_un& Addr){
+  std::memset(&Addr, 0, sizeof(Addr));
+  Addr.sun_family = AF_UNIX;
+  if( Path.empty() || (Path.size() >= sizeof(Addr.sun_path)) )
+    return false;
+  std::memcpy(Addr.sun_path, Path.c_str(), Path.size());
+  return true;
+}
+
+// DebugSockServer: the launcher side of the protocol
+//
+// Broadcast() may be called from any thread.  Client sockets are non
+// blocking; output a client cannot take immediately is buffered and
+// flushed from Poll(), and a client that falls too far behind is
+// disconnected rather than stalling the launcher.
+class DebugSockServer {
+public:
+  DebugSockServer() = default;
+  ~DebugSockServer(){ Close(); }
+
+  bool Listen(const std::string& Path){
+    struct sockaddr_un Addr;
+    if( !SockAddr(Path, Addr) )
+      return false;
+    m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if( m_fd == -1 )
+      return false;
+    unlink(Path.c_str());
+    if( (bind(m_fd, (struct sockaddr *)(&Addr), sizeof(Addr)) == -1) ||
+        (listen(m_fd, 4) == -1) ){
+      close(m_fd);
+      m_fd = -1;
+      return false;
+    }
+    m_path = Path;
+    return true;
+  }
+
+  /// Greeting sent to every new client
+  void SetHello(const std::string& Line){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hello = Line;
+  }
+
+  /// Sends a line to every attached client
+  void Broadcast(const std::string& Line){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for( auto& C : m_clients )
+      Send(C, Line);
+  }
+
+  /// Accepts new clients, flushes pending output and collects the
+  /// command lines received since the last call
+  void Poll(std::vector<std::string>& Cmds){
+    if( m_fd == -1 )
+      return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    int fd;
+    while( (fd = accept4(m_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) != -1 ){
+      m_clients.push_back({fd, "", "", false});
+      if( !m_hello.empty() )
+        Send(m_clients.back(), m_hello);
+    }
+
+    char Buf[1024];
+    for( auto& C : m_clients ){
+      ssize_t n;
+      while( (n = recv(C.fd, Buf, sizeof(Buf), 0)) > 0 ){
+        C.in.append(Buf, n);
+      }
+      if( (n == 0) || ((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) )
+        C.closed = true;
+
+      size_t pos;
+      while( (pos = C.in.find('\n')) != std::string::npos ){
+        std::string Line = C.in.substr(0, pos);
+        C.in.erase(0, pos+1);
+        if( Line == "detach" )
+          C.closed = true;
+        else if( !Line.empty() )
+          Cmds.push_back(Line);
+      }
+      Flush(C);
+    }
+
+    for( auto it = m_clients.begin(); it != m_clients.end(); ){
+      if( it->closed ){
+        close(it->fd);
+        it = m_clients.erase(it);
+      }else{
+        ++it;
+      }
+    }
+  }
+
+  /// Number of attached clients
+  size_t Clients(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clients.size();
+  }
+
+  void Close(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for( auto& C : m_clients ){
+      Flush(C);
+      close(C.fd);
+    }
+    m_clients.clear();
+    if( m_fd != -1 ){
+      close(m_fd);
+      unlink(m_path.c_str());
+      m_fd = -1;
+    }
+  }
+
+private:
+  static constexpr size_t MaxPending = 4 << 20;  // bytes buffered per client
+
+  typedef struct{
+    int fd;
+    std::string in;       // partial command line
+    std::string out;      // output not yet taken by the client
+    bool closed;
+  }CLIENT;
+
+  void Send(CLIENT& C, const std::string& Line){
+    if( C.closed )
+      return;
+    C.out += Line;
+    C.out += '\n';
+    Flush(C);
+    if( C.out.size() > MaxPending )
+      C.closed = true;
+  }
+
+  void Flush(CLIENT& C){
+    while( !C.out.empty() && !C.closed ){
+      ssize_t n = send(C.fd, C.out.data(), C.out.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+      if( n > 0 ){
+        C.out.erase(0, n);
+      }else if( (n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ){
+        return;
+      }else if( (n < 0) && (errno == EINTR) ){
+        continue;
+      }else{
+        C.closed = true;
+      }
+    }
+  }
+
+  int m_fd{-1};
+  std::string m_path;
+  std::string m_hello;
+  std::vector<CLIENT> m_clients;
+  std::mutex m_mutex;
+};
+
+// DebugSockClient: the console side of the protocol
+//
+// A reader thread hands every received line to the line callback and
+// calls the close callback once the launcher goes away.
+class DebugSockClient {
+public:
+  using LineFn = std::function<void(const std::string&)>;
+  using CloseFn = std::function<void()>;
+
+  DebugSockClient() = default;
+  ~DebugSockClient(){ Detach(); }
+
+  /// Connects to the launcher, retrying for up to Timeout milliseconds
+  /// while the socket is being created
+  bool Attach(const std::string& Path, LineFn OnLine, CloseFn OnClose,
+              unsigned Timeout = 0){
+    struct sockaddr_un Addr;
+    if( !SockAddr(Path, Addr) )
+      return false;
+
+    for( unsigned Waited = 0;; Waited += 50 ){
+      m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if( m_fd == -1 )
+        return false;
+      if( connect(m_fd, (struct sockaddr *)(&Addr), sizeof(Addr)) == 0 )
+        break;
+      close(m_fd);
+      m_fd = -1;
+      if( Waited >= Timeout )
+        return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    m_path = Path;
+    m_thread = std::thread(&DebugSockClient::Reader, this, std::move(OnLine),
+                           std::move(OnClose));
+    return true;
+  }
+
+  bool Attached() const { return m_fd != -1; }
+  const std::string& Path() const { return m_path; }
+
+  /// Sends a command line to the launcher
+  bool Send(const std::string& Cmd){
+    if( m_fd == -1 )
+      return false;
+    std::string Line = Cmd + "\n";
+    const char *p = Line.data();
+    size_t left = Line.size();
+    while( left > 0 ){
+      ssize_t n = send(m_fd, p, left, MSG_NOSIGNAL);
+      if( n < 0 ){
+        if( errno == EINTR )
+          continue;
+        return false;
+      }
+      p += n;
+      left -= n;
+    }
+    return true;
+  }
+
+  /// Closes the connection; the launcher and its job keep running
+  void Detach(){
+    if( m_fd != -1 ){
+      Send("detach");
+      shutdown(m_fd, SHUT_RDWR);
+    }
+    if( m_thread.joinable() && (m_thread.get_id() != std::this_thread::get_id()) )
+      m_thread.join();
+    else if( m_thread.joinable() )
+      m_thread.detach();
+    if( m_fd != -1 ){
+      close(m_fd);
+      m_fd = -1;
+    }
+  }
+
+private:
+  void Reader(LineFn OnLine, CloseFn OnClose){
+    char Buf[4096];
+    std::string Line;
+    ssize_t n;
+    while( (n = recv(m_fd, Buf, sizeof(Buf), 0)) != 0 ){
+      if( n < 0 ){
+        if( errno == EINTR )
+          continue;
+        break;
+      }
+      for( ssize_t i=0; i<n; i++ ){
+        if( Buf[i] == '\n' ){
+          OnLine(Line);
+          Line.clear();
+        }else{
+          Line += Buf[i];
+        }
+      }
+    }
+    if( OnClose )
+      OnClose();
+  }
+
+  int m_fd{-1};
+  std::string m_path;
+  std::thread m_thread;
+};
+
+#endif  // #ifndef _SSTDEBUGSOCK_H_
+
+// EOF
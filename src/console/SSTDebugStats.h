@@ -0,0 +1,243 @@
+//
+// _SSTDebugStats_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGSTATS_H_
+#define _SSTDEBUGSTATS_H_
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "SSTDebugProc.h"
+
+// DumpRec: launcher-side record of a single dump trigger
+typedef struct{
+  unsigned Id;        // trigger number
+  double Sent;        // seconds since launch the signal was sent
+  double Completed;   // seconds since launch the last dump write was observed
+  uint64_t Bytes;     // bytes written by the dump
+  unsigned Files;     // number of dump files created
+  double CPU;         // child CPU seconds consumed between send and completion
+  bool Done;          // has the dump been observed to complete?
+}DUMPREC;
+
+class DumpStats {
+public:
+  DumpStats(const std::string& Dir)
+    : m_dir(Dir), m_start(std::chrono::steady_clock::now()) {
+  }
+
+  /// Records a new trigger and snapshots the dump directory
+  void Trigger(pid_t pid){
+    // a new trigger closes any dump that has not yet quiesced
+    Finish();
+
+    DUMPREC R;
+    R.Id        = (unsigned)(m_recs.size());
+    R.Sent      = Now();
+    R.Completed = R.Sent;
+    R.Bytes     = 0;
+    R.Files     = 0;
+    R.CPU       = 0.;
+    R.Done      = false;
+    m_recs.push_back(R);
+
+    ReadProcStat(pid, m_cpu_sent);
+    m_cpu_last = m_cpu_sent;
+    Scan(m_baseline);
+    m_inflight = true;
+  }
+
+  /// Samples the dump directory while a dump is in flight; returns the
+  /// record of a dump that has just quiesced, otherwise nullptr
+  const DUMPREC *Poll(pid_t pid){
+    if( !m_inflight )
+      return nullptr;
+
+    double T = Now();
+    if( (T - m_last_poll) < PollInterval )
+      return nullptr;
+    m_last_poll = T;
+
+    std::unordered_map<std::string,uintmax_t> Cur;
+    Scan(Cur);
+
+    uint64_t Bytes = 0;
+    unsigned Files = 0;
+    for( const auto& F : Cur ){
+      auto it = m_baseline.find(F.first);
+      if( it == m_baseline.end() ){
+        Files++;
+        Bytes += F.second;
+      }else if( F.second > it->second ){
+        // appended files (MPI builds) only count the new bytes
+        Bytes += F.second - it->second;
+      }
+    }
+
+    DUMPREC &R = m_recs.back();
+    if( (Bytes != R.Bytes) || (Files != R.Files) ){
+      R.Bytes     = Bytes;
+      R.Files     = Files;
+      R.Completed = T;
+      ReadProcStat(pid, m_cpu_last);
+      R.CPU = ProcCPUSeconds(m_cpu_last) - ProcCPUSeconds(m_cpu_sent);
+    }else if( (R.Files > 0) && ((T - R.Completed) >= QuiesceInterval) ){
+      // no new output since the last write; the dump is complete
+      Finish();
+      return &R;
+    }
+    return nullptr;
+  }
+
+  /// Closes the in-flight dump with whatever has been observed
+  void Finish(){
+    if( !m_inflight )
+      return;
+    m_recs.back().Done = (m_recs.back().Files > 0);
+    m_inflight = false;
+    m_baseline.clear();
+  }
+
+  /// Records the total child CPU time for the summary
+  void SampleChild(pid_t pid){
+    PROCSAMPLE S;
+    if( ReadProcStat(pid, S) )
+      m_child_cpu = ProcCPUSeconds(S);
+  }
+
+  /// Prints the summary table
+  void PrintSummary(std::ostream& os){
+    Finish();
+
+    double Wall = Now();
+    double Latency = 0.;
+    double MaxLatency = 0.;
+    double CPU = 0.;
+    uint64_t Bytes = 0;
+    unsigned Files = 0;
+
+    os << "<<SSTDBG>> Dump summary : " << m_recs.size() << " triggers" << std::endl;
+    os << "<<SSTDBG>> " << std::setw(6) << "ID"
+       << std::setw(12) << "SENT(s)"
+       << std::setw(12) << "LATENCY(s)"
+       << std::setw(8) << "FILES"
+       << std::setw(14) << "BYTES"
+       << std::setw(10) << "CPU(s)" << std::endl;
+    for( const auto& R : m_recs ){
+      double L = R.Completed - R.Sent;
+      os << "<<SSTDBG>> " << std::setw(6) << R.Id
+         << std::fixed << std::setprecision(3)
+         << std::setw(12) << R.Sent
+         << std::setw(12) << L
+         << std::setw(8) << R.Files
+         << std::setw(14) << R.Bytes
+         << std::setw(10) << R.CPU
+         << (R.Done ? "" : "  (incomplete)") << std::endl;
+      Latency += L;
+      MaxLatency = std::max(MaxLatency,L);
+      CPU += R.CPU;
+      Bytes += R.Bytes;
+      Files += R.Files;
+    }
+
+    os << std::fixed << std::setprecision(3);
+    os << "<<SSTDBG>> Total files  = " << Files << std::endl;
+    os << "<<SSTDBG>> Total bytes  = " << Bytes << std::endl;
+    if( !m_recs.empty() ){
+      os << "<<SSTDBG>> Mean latency = " << Latency/m_recs.size() << " s" << std::endl;
+      os << "<<SSTDBG>> Max latency  = " << MaxLatency << " s" << std::endl;
+    }
+    os << "<<SSTDBG>> Dump CPU     = " << CPU << " s of "
+       << m_child_cpu << " s child CPU" << std::endl;
+    os << "<<SSTDBG>> Dump wall    = " << Latency << " s of "
+       << Wall << " s wall (" << (Wall > 0. ? 100.*Latency/Wall : 0.)
+       << "%)" << std::endl;
+    os << std::defaultfloat;
+  }
+
+  /// Exports the records; the format is selected by the file extension
+  bool Export(const std::string& File){
+    Finish();
+
+    std::ofstream Out(File);
+    if( !Out.is_open() )
+      return false;
+
+    Out << std::fixed << std::setprecision(6);
+    if( std::filesystem::path(File).extension() == ".json" ){
+      Out << "[" << std::endl;
+      for( unsigned i=0; i<m_recs.size(); i++ ){
+        const auto& R = m_recs[i];
+        Out << "{\"Id\": " << R.Id
+            << ", \"Sent\": " << R.Sent
+            << ", \"Completed\": " << R.Completed
+            << ", \"Latency\": " << R.Completed - R.Sent
+            << ", \"Files\": " << R.Files
+            << ", \"Bytes\": " << R.Bytes
+            << ", \"CPU\": " << R.CPU
+            << ", \"Done\": " << (R.Done ? "true" : "false") << "}"
+            << ((i+1) < m_recs.size() ? "," : "") << std::endl;
+      }
+      Out << "]" << std::endl;
+    }else{
+      Out << "Id,Sent,Completed,Latency,Files,Bytes,CPU,Done" << std::endl;
+      for( const auto& R : m_recs ){
+        Out << R.Id << "," << R.Sent << "," << R.Completed << ","
+            << R.Completed - R.Sent << "," << R.Files << "," << R.Bytes << ","
+            << R.CPU << "," << R.Done << std::endl;
+      }
+    }
+    Out.close();
+    return true;
+  }
+
+private:
+  static constexpr double PollInterval    = 0.1;  // directory scan interval (sec)
+  static constexpr double QuiesceInterval = 0.5;  // idle time before a dump is complete (sec)
+
+  double Now(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+  }
+
+  void Scan(std::unordered_map<std::string,uintmax_t>& Files){
+    std::error_code ec;
+    for( const auto& entry : std::filesystem::directory_iterator(m_dir, ec) ){
+      const auto Ext = entry.path().extension();
+      if( (Ext == ".json") || (Ext == ".out") ){
+        std::error_code sec;
+        uintmax_t Size = entry.file_size(sec);
+        if( !sec )
+          Files[entry.path().filename().string()] = Size;
+      }
+    }
+  }
+
+  std::string m_dir;
+  std::chrono::steady_clock::time_point m_start;
+  std::vector<DUMPREC> m_recs;
+  std::unordered_map<std::string,uintmax_t> m_baseline;
+  PROCSAMPLE m_cpu_sent{};
+  PROCSAMPLE m_cpu_last{};
+  double m_child_cpu{0.};
+  double m_last_poll{0.};
+  bool m_inflight{false};
+};
+
+#endif  // #ifndef _SSTDEBUGSTATS_H_
+
+// EOF
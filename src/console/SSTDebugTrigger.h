@@ -0,0 +1,168 @@
+//
+// _SSTDebugTrigger_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGTRIGGER_H_
+#define _SSTDEBUGTRIGGER_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "SSTDebugProc.h"
+
+// DumpTriggers: condition predicates evaluated against the child process
+//
+// Resource predicates are edge triggered: a predicate fires once when its
+// condition becomes true and re-arms only after the condition clears.  All
+// predicates share a debounce window so that a burst of matching log lines
+// or a flapping condition cannot flood the run with dumps.
+class DumpTriggers {
+public:
+  DumpTriggers() : m_start(std::chrono::steady_clock::now()) {}
+
+  /// Fire when the child's resident set size exceeds MB megabytes
+  void SetRSS(uint64_t MB){ m_rss_limit = MB * 1024; }
+
+  /// Fire when the child's CPU time has not advanced for Sec seconds
+  void SetStall(double Sec){ m_stall = Sec; }
+
+  /// Fire when a line of the child's stdout matches the expression
+  bool AddWatch(const std::string& Expr){
+    try{
+      m_watch.emplace_back(Expr, std::regex::ECMAScript | std::regex::optimize);
+      m_watch_str.push_back(Expr);
+    }catch( const std::regex_error& ){
+      return false;
+    }
+    return true;
+  }
+
+  /// Minimum number of seconds between two predicate-triggered dumps
+  void SetDebounce(double Sec){ m_debounce = Sec; }
+
+  /// Are any predicates enabled?
+  bool Enabled() const {
+    return (m_rss_limit > 0) || (m_stall > 0.) || !m_watch.empty();
+  }
+
+  /// Does the launcher need to tail the child's stdout?
+  bool Watching() const { return !m_watch.empty(); }
+
+  /// Matches a line of child output; called from the stdout tail thread
+  void OnLine(const std::string& Line){
+    if( m_line_pending.load(std::memory_order_relaxed) )
+      return;
+    for( unsigned i=0; i<m_watch.size(); i++ ){
+      if( std::regex_search(Line, m_watch[i]) ){
+        std::lock_guard<std::mutex> lock(m_line_mutex);
+        m_line_reason = "watch \"" + m_watch_str[i] + "\" matched";
+        m_line_pending.store(true, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  /// Evaluates the predicates; returns true if a dump should fire now
+  bool Poll(pid_t pid, std::string& Reason){
+    double T = Now();
+    bool Fire = false;
+
+    // watched output lines are edges by nature
+    if( m_line_pending.load(std::memory_order_acquire) ){
+      std::lock_guard<std::mutex> lock(m_line_mutex);
+      Reason = m_line_reason;
+      m_line_pending.store(false, std::memory_order_release);
+      Fire = true;
+    }
+
+    // resource predicates are sampled at a fixed cadence
+    if( (m_rss_limit > 0 || m_stall > 0.) &&
+        ((T - m_last_sample) >= SampleInterval) ){
+      m_last_sample = T;
+
+      if( m_rss_limit > 0 ){
+        uint64_t RSS = 0;
+        if( ReadProcRSS(pid, RSS) ){
+          bool Cond = (RSS > m_rss_limit);
+          if( Cond && m_rss_armed ){
+            Reason = "RSS " + std::to_string(RSS/1024) + " MB exceeds " +
+                     std::to_string(m_rss_limit/1024) + " MB";
+            Fire = true;
+          }
+          m_rss_armed = !Cond;
+        }
+      }
+
+      if( m_stall > 0. ){
+        PROCSAMPLE S;
+        if( ReadProcStat(pid, S) ){
+          double CPU = ProcCPUSeconds(S);
+          if( CPU != m_last_cpu ){
+            m_last_cpu = CPU;
+            m_last_progress = T;
+          }
+          bool Cond = ((T - m_last_progress) >= m_stall);
+          if( Cond && m_stall_armed ){
+            Reason = "CPU stalled for " + std::to_string((unsigned)(T - m_last_progress)) + " s";
+            Fire = true;
+          }
+          m_stall_armed = !Cond;
+        }
+      }
+    }
+
+    if( !Fire )
+      return false;
+
+    // debounce: suppress the dump if we fired recently
+    if( m_fired && ((T - m_last_fire) < m_debounce) )
+      return false;
+    m_fired = true;
+    m_last_fire = T;
+    return true;
+  }
+
+private:
+  static constexpr double SampleInterval = 0.25;  // /proc sample interval (sec)
+
+  double Now(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+  }
+
+  std::chrono::steady_clock::time_point m_start;
+
+  // resource predicates
+  uint64_t m_rss_limit{0};        // RSS limit in kB
+  double m_stall{0.};             // stall window in seconds
+  bool m_rss_armed{true};
+  bool m_stall_armed{true};
+  double m_last_cpu{-1.};
+  double m_last_progress{0.};
+  double m_last_sample{-1.};
+
+  // output predicates
+  std::vector<std::regex> m_watch;
+  std::vector<std::string> m_watch_str;
+  std::atomic<bool> m_line_pending{false};
+  std::mutex m_line_mutex;
+  std::string m_line_reason;
+
+  // debounce
+  double m_debounce{10.};
+  double m_last_fire{0.};
+  bool m_fired{false};
+};
+
+#endif  // #ifndef _SSTDEBUGTRIGGER_H_
+
+// EOF
@@ -11,19 +11,24 @@
 #include "DebugConsole.h"
 #include "nlohmann/json.hpp"
 #include "nlohmann/json_fwd.hpp"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <filesystem>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <mutex>
 #include <signal.h>
+#include <sstream>
 #include <string>
 #include <sys/wait.h>
 #include <thread>
+#include <unistd.h>
 // #include <future>
 #include <iostream>
 using nlohmann::json;
@@ -43,18 +48,29 @@ void DebugConsole::Init() {
 
   InputFieldComponent = Input(&userInput, "[enter your command here]");
 
-  MsgFrameComponent = Renderer([&] {
-    Elements DebugMsgElements{};
-    for (const auto &message : MsgQueue) {
-      DebugMsgElements.emplace_back(DebugMsgToFtxElement(message));
-    }
-    return vbox(std::move(DebugMsgElements));
-  });
-
-  MsgScrollerComponent = Scroller(MsgFrameComponent); //| Maybe(&TableView);
-
-  MainContainerComponent =
-      Container::Vertical({MsgScrollerComponent, InputFieldComponent});
+  // Only the visible rows of the message log are built on each frame
+  MsgScrollerComponent = VirtualScroller(
+      [&] {
+        std::lock_guard<std::mutex> lock(m_msg_mutex);
+        return int(MsgQueue.size());
+      },
+      [&](int i) {
+        std::lock_guard<std::mutex> lock(m_msg_mutex);
+        return DebugMsgToFtxElement(MsgQueue.at(size_t(i)));
+      });
+
+  // Table rows are built from the store for the visible window only
+  TableScrollerComponent =
+      VirtualScroller([&] { return TableRowCount(); },
+                      [&](int i) { return TableRow(i); });
+
+  PlotComponent = Renderer([&] { return PlotView(); });
+
+  MainContainerComponent = Container::Vertical(
+      {Container::Tab(
+           {MsgScrollerComponent, TableScrollerComponent, PlotComponent},
+           &ViewTab),
+       InputFieldComponent});
   MainContainerComponent |=
       CatchEvent([&](Event e) { return ContainerEventHandler(e); });
 
@@ -64,7 +80,10 @@ void DebugConsole::Init() {
                  // What is being rendered here is a vertical stack, and then
                  // we render a horizontal stack over it, which is used to
                  // position the autocomplete window
-                 dbox({vbox({MsgScrollerComponent->Render(), filler()}),
+                 dbox({vbox({ViewTab == 0   ? MsgScrollerComponent->Render()
+                             : ViewTab == 1 ? TableView()
+                                            : PlotView() | flex,
+                             filler()}),
                        hbox({
                            filler(),
                            vbox({
@@ -120,25 +139,37 @@ void DebugConsole::Init() {
 // }
 
 bool DebugConsole::DumpFileContents(const std::string &Filename) {
-  std::ifstream input_file(Filename, std::ifstream::in);
-
-  if (Filename.find(".json") != std::string::npos) {
-    // JSON Output
-    json j;
-    input_file >> j;
+  std::vector<DumpRecord> Records;
+  Records.push_back(parse_dump_file(Filename));
+  OnDumpRecords(std::move(Records));
+  return 0;
+}
 
-    for (auto it = j.begin(); it != j.end(); ++it) {
-      OnLog({'\t' + it.key() + ":\t" + it.value().dump()});
+// ============================
+// DebugConsole::OnDumpRecords
+// --> Called from the dump parser threads
+// ============================
+void DebugConsole::OnDumpRecords(std::vector<DumpRecord> &&records) {
+  {
+    std::lock_guard<std::mutex> lock(m_store_mutex);
+    for (const auto &record : records) {
+      Store.Add(record);
+      Index.Add(record);
     }
   }
 
-  else {
-    std::string line;
-    while (getline(input_file, line)) {
-      OnLog({'\t' + line});
+  std::vector<DebugMsg> messages;
+  for (const auto &record : records) {
+    messages.push_back({"$b[SSTDebug] New Dump Found: " + record.file});
+    if (!record.valid) {
+      messages.push_back({"$r[SSTDebug] Unable to parse dump: " + record.error});
+      continue;
+    }
+    for (const auto &value : record.values) {
+      messages.push_back({'\t' + value.first + ":\t" + value.second});
     }
   }
-  return 0;
+  OnLogBatch(std::move(messages));
 }
 
 // void DebugConsole::ReadFile(const std::string &Filename) {
@@ -208,14 +239,35 @@ void DebugConsole::Shutdown() {
   stopListening = true;
   screen.Post([&] { screen.ExitLoopClosure()(); });
   ListenerThread.join();
+  DetachLauncher();
 }
 
 // ============================
 // DebugConsole:OnLog
 // ============================
 void DebugConsole::OnLog(const DebugMsg &message) {
+  // parse outside the lock; the renderer only reads the spans
+  DebugMsg parsed = message;
+  parsed.Parse();
+
   std::unique_lock<std::mutex> lock(m_msg_mutex);
-  MsgQueue.push_back(message);
+  MsgQueue.push_back(std::move(parsed));
+  TimeToUpdate = -1.0f; // update ui
+  lock.unlock();
+}
+
+// ============================
+// DebugConsole:OnLogBatch
+// ============================
+void DebugConsole::OnLogBatch(std::vector<DebugMsg> &&messages) {
+  for (auto &message : messages) {
+    message.Parse();
+  }
+
+  std::unique_lock<std::mutex> lock(m_msg_mutex);
+  for (auto &message : messages) {
+    MsgQueue.push_back(std::move(message));
+  }
   TimeToUpdate = -1.0f; // update ui
   lock.unlock();
 }
@@ -255,7 +307,9 @@ bool DebugConsole::ContainerEventHandler(Event e) {
   if (e == Event::ArrowUp // TODO: Make cycle through CommandHistory
       || e == Event::PageUp || e == Event::ArrowDown || e == Event::PageDown ||
       e == Event::Home || e == Event::End) {
-    MsgScrollerComponent->OnEvent(e);
+    if (ViewTab != 2) {
+      (ViewTab == 0 ? MsgScrollerComponent : TableScrollerComponent)->OnEvent(e);
+    }
     return true;
   }
 
@@ -297,68 +351,40 @@ bool DebugConsole::ContainerEventHandler(Event e) {
 // DebugConsole::DebugMsgToFtxElement
 // ============================
 Element DebugConsole::DebugMsgToFtxElement(const DebugMsg &message) {
-  static std::unordered_map<char, Color> ColorMap{
-      {'r', Color::Red},        {'o', Color::Orange1},   {'y', Color::Yellow},
-      {'g', Color::GreenLight}, {'b', Color::BlueLight}, {'p', Color::Pink1},
-      {'w', Color::White},      {'G', Color::GrayLight}};
-
-  char currentColor = 'w';
   Elements coloredTexts{};
-  ElementDecorator textColor = color(ColorMap[currentColor]);
-  std::string string;
-  for (size_t i = 0; i < message.text.size(); i++) {
-    if (message.text[i] == '$') {
-      if (!string.empty()) {
-        coloredTexts.emplace_back(text(string) | textColor);
-        string.clear();
-      }
-
-      i++;
-      if (i >= message.text.size()) {
-        break;
-      }
-
-      currentColor = message.text[i];
-
-      auto iterator = ColorMap.find(currentColor);
-      if (iterator == ColorMap.end()) {
-        textColor = color(Color::White);
-      } else {
-        textColor = color(iterator->second);
-      }
-
-      i++;
-      if (i >= message.text.size()) {
-        break;
-      }
-    }
-
-    string += message.text[i];
-
-    if (i == message.text.size() - 1) {
-      coloredTexts.emplace_back(text(string) | textColor);
-    }
+  coloredTexts.reserve(message.spans.size());
+  for (const auto &span : message.spans) {
+    coloredTexts.emplace_back(
+        text(message.text.substr(span.offset, span.length)) |
+        color(SpanColor(span.color)));
   }
 
-  return hbox({text(GenerateTimeString(message)), separator(), text(" "),
+  return hbox({text(message.timeString), separator(), text(" "),
                hbox(std::move(coloredTexts))});
 }
 
 // ============================
-// DebugConsole::GenerateTimeString
+// DebugConsole::SpanColor
 // ============================
-const char *DebugConsole::GenerateTimeString(const DebugMsg &message) {
-  // mmm:ss.ssss
-  static char buffer[16];
-
-  const int iTime = message.timeSubmitted;
-  const int seconds = int(message.timeSubmitted) % 60;
-  const int minutes = iTime / 60;
-
-  const float flSeconds = seconds + (message.timeSubmitted - iTime);
-
-  snprintf(buffer, 16, "%03i:%06.3f ", minutes, flSeconds);
-  return buffer;
+Color DebugConsole::SpanColor(char code) {
+  switch (code) {
+  case 'r':
+    return Color::Red;
+  case 'o':
+    return Color::Orange1;
+  case 'y':
+    return Color::Yellow;
+  case 'g':
+    return Color::GreenLight;
+  case 'b':
+    return Color::BlueLight;
+  case 'p':
+    return Color::Pink1;
+  case 'G':
+    return Color::GrayLight;
+  default:
+    return Color::White;
+  }
 }
 
 // ============================
@@ -400,26 +426,558 @@ void DebugConsole::PrintHelp() {
   OnLog({"$g - [!]               -- All commands issued with a bang(!) prefix will be executed as a shell command"});
   OnLog({"$g - [exit|q|quit]     -- Quit console (NOTE: Ends sst processes started within console"});
   OnLog({"$g - [run]             -- Execute SST via sst-dbg"});
+  OnLog({"$g - [table [vars]]    -- Show components x variables at their latest cycle"});
+  OnLog({"$g - [table off]       -- Return to the message log"});
+  OnLog({"$g - [pin <comp>]      -- Show the history of a component across cycles"});
+  OnLog({"$g - [unpin]           -- Return to the component table"});
+  OnLog({"$g - [plot <comp> <var>] -- Plot a numeric variable of a component over cycles"});
+  OnLog({"$g - [plot off]        -- Return to the message log"});
+  OnLog({"$g - [attach <socket>]  -- Attach to a running sst-dbg --socket job"});
+  OnLog({"$g - [detach]          -- Detach from the job; it keeps running"});
+  OnLog({"$g - [dump]            -- Dump the attached job now"});
+  OnLog({"$g - [pause|resume]    -- Stop or continue the attached job"});
+  OnLog({"$g - [interval <sec>]  -- Change the attached job's dump interval (0 = off)"});
+  OnLog({"$g - [status]          -- Print the attached job's status"});
+  OnLog({"$g - [find key]        -- Components and cycles holding a key"});
+  OnLog({"$g - [find key=value]  -- Components and cycles where key had value"});
+  OnLog({"$g - [find =value]     -- Components and cycles where any key had value"});
   OnLog({"$b                        - ex. run --iter 5 -- sst MyTest.py"});
   OnLog({"$b                        - ex. run --i 10 -- mpirun MyTest.py"});
   OnLog({"$b                        - ex. run --rand -- sst MyTest.py"});
 }
 
+// ============================
+// DebugConsole::TableCommand
+// ============================
+void DebugConsole::TableCommand(const std::string &args) {
+  std::istringstream ss(args);
+  std::vector<std::string> vars;
+  std::string var;
+  while (ss >> var) {
+    vars.push_back(var);
+  }
+
+  if (vars.size() == 1 && vars[0] == "off") {
+    ViewTab = 0;
+    JumpToBottom = true;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_store_mutex);
+    TableVars = std::move(vars);
+  }
+  ViewTab = 1;
+}
+
+// ============================
+// DebugConsole::PinCommand
+// ============================
+void DebugConsole::PinCommand(const std::string &args) {
+  std::istringstream ss(args);
+  std::string comp;
+  ss >> comp;
+
+  std::lock_guard<std::mutex> lock(m_store_mutex);
+  if (!comp.empty() && Store.FindComponent(comp) == -1) {
+    OnLog({"$r[SSTDebug] Unknown component: " + comp});
+    return;
+  }
+  PinnedComponent = comp;
+  ViewTab = 1;
+}
+
+// ============================
+// DebugConsole::TableColumns
+// --> m_store_mutex must be held
+// ============================
+std::vector<size_t> DebugConsole::TableColumns() const {
+  std::vector<size_t> cols;
+  if (TableVars.empty()) {
+    for (size_t col = 0; col < Store.NumVars(); col++) {
+      cols.push_back(col);
+    }
+  } else {
+    for (const auto &var : TableVars) {
+      int col = Store.FindVar(var);
+      if (col != -1) {
+        cols.push_back(size_t(col));
+      }
+    }
+  }
+  return cols;
+}
+
+// ============================
+// DebugConsole::TableRowCount
+// ============================
+int DebugConsole::TableRowCount() {
+  std::lock_guard<std::mutex> lock(m_store_mutex);
+  int pinned = PinnedComponent.empty() ? -1 : Store.FindComponent(PinnedComponent);
+  if (pinned != -1) {
+    return int(Store.HistorySize(size_t(pinned)));
+  }
+  return int(Store.NumComponents());
+}
+
+// Fixed width table cell
+static Element TableCell(const std::string &value, size_t width) {
+  std::string cell = value.empty() ? "-" : value.substr(0, width);
+  return text(cell) | size(WIDTH, EQUAL, int(width) + 2);
+}
+
+// ============================
+// DebugConsole::TableHeader
+// ============================
+Element DebugConsole::TableHeader() {
+  std::lock_guard<std::mutex> lock(m_store_mutex);
+  Elements cells;
+  if (PinnedComponent.empty()) {
+    cells.push_back(TableCell("Component", 24) | color(Color::BlueLight));
+  } else {
+    cells.push_back(TableCell(PinnedComponent, 24) | color(Color::BlueLight));
+  }
+  cells.push_back(TableCell("Cycle", 12) | color(Color::BlueLight));
+  for (auto col : TableColumns()) {
+    cells.push_back(TableCell(Store.Var(col), Store.Width(col)) |
+                    color(Color::BlueLight));
+  }
+  return hbox(std::move(cells)) | bold;
+}
+
+// ============================
+// DebugConsole::TableRow
+// ============================
+Element DebugConsole::TableRow(int i) {
+  std::lock_guard<std::mutex> lock(m_store_mutex);
+  Elements cells;
+  int pinned = PinnedComponent.empty() ? -1 : Store.FindComponent(PinnedComponent);
+  if (pinned != -1) {
+    // history of the pinned component, one cycle per row
+    const size_t row = size_t(pinned);
+    if (size_t(i) >= Store.HistorySize(row)) {
+      return text("");
+    }
+    cells.push_back(TableCell("", 24));
+    cells.push_back(TableCell(std::to_string(Store.HistoryCycle(row, i)), 12));
+    for (auto col : TableColumns()) {
+      cells.push_back(TableCell(Store.HistoryValue(row, i, col), Store.Width(col)));
+    }
+  } else {
+    // every component at its latest cycle
+    if (size_t(i) >= Store.NumComponents()) {
+      return text("");
+    }
+    cells.push_back(TableCell(Store.Component(i), 24) | color(Color::GreenLight));
+    cells.push_back(TableCell(std::to_string(Store.LatestCycle(i)), 12));
+    for (auto col : TableColumns()) {
+      cells.push_back(TableCell(Store.Latest(i, col), Store.Width(col)));
+    }
+  }
+  return hbox(std::move(cells));
+}
+
+// ============================
+// DebugConsole::TableView
+// ============================
+Element DebugConsole::TableView() {
+  return vbox({TableHeader(), separatorLight(),
+               TableScrollerComponent->Render() | flex});
+}
+
+// ============================
+// DebugConsole::PlotCommand
+// ============================
+void DebugConsole::PlotCommand(const std::string &args) {
+  std::istringstream ss(args);
+  std::string comp, var;
+  ss >> comp >> var;
+
+  if (comp == "off") {
+    ViewTab = 0;
+    JumpToBottom = true;
+    return;
+  }
+  if (var.empty()) {
+    OnLog({"$r[SSTDebug] Usage: plot <component> <variable> | plot off"});
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_store_mutex);
+  int row = Store.FindComponent(comp);
+  int col = Store.FindVar(var);
+  if (row == -1 || col == -1) {
+    lock.unlock();
+    OnLog({"$r[SSTDebug] Unknown " +
+           std::string(row == -1 ? "component: " + comp : "variable: " + var)});
+    return;
+  }
+
+  // start maintaining the series; new dumps are appended as they arrive
+  Store.Track(size_t(row), size_t(col));
+  PlotComp = comp;
+  PlotVar = var;
+  ViewTab = 2;
+}
+
+// ============================
+// DebugConsole::PlotView
+// ============================
+Element DebugConsole::PlotView() {
+  std::lock_guard<std::mutex> lock(m_store_mutex);
+  int row = Store.FindComponent(PlotComp);
+  int col = Store.FindVar(PlotVar);
+  if (row == -1 || col == -1) {
+    return text("");
+  }
+
+  const MinMaxSeries &series = Store.Track(size_t(row), size_t(col));
+  const double lo = series.Min();
+  const double hi = series.Max();
+  const auto &buckets = series.Buckets();
+
+  char range[96];
+  snprintf(range, sizeof(range), "min %g  max %g", lo, hi);
+  std::string cycles =
+      series.Empty() ? "no numeric values"
+                     : "cycles " + std::to_string(buckets.front().first_cycle) +
+                           ".." + std::to_string(buckets.back().last_cycle) +
+                           "  (" + std::to_string(series.Points()) + " points)";
+
+  // buckets are copied so the canvas can be drawn outside the lock
+  auto chart = canvas([buckets, lo, hi](Canvas &c) {
+    const int W = c.width();
+    const int H = c.height();
+    const size_t N = buckets.size();
+    if (N == 0 || W < 2 || H < 2) {
+      return;
+    }
+    auto Y = [&](double v) {
+      return (hi == lo) ? H / 2 : int((hi - v) / (hi - lo) * (H - 1));
+    };
+    auto X = [&](size_t i) {
+      return (N <= size_t(W)) ? (N == 1 ? 0 : int(i * (W - 1) / (N - 1)))
+                              : int(i * W / N);
+    };
+
+    // one vertical min/max stroke per bucket, joined first to last
+    for (size_t i = 0; i < N; i++) {
+      const auto &b = buckets[i];
+      const int x = X(i);
+      c.DrawPointLine(x, Y(b.min), x, Y(b.max), Color::GreenLight);
+      if (i > 0) {
+        c.DrawPointLine(X(i - 1), Y(buckets[i - 1].last), x, Y(b.first),
+                        Color::GreenLight);
+      }
+    }
+  });
+
+  return vbox({hbox({text(PlotComp + " / " + PlotVar) | bold |
+                         color(Color::BlueLight),
+                     filler(), text(range), text("  "), text(cycles)}),
+               separatorLight(), chart | flex});
+}
+
+// ============================
+// DebugConsole::FindCommand
+// ============================
+void DebugConsole::FindCommand(const std::string &args) {
+  const size_t b = args.find_first_not_of(" \t");
+  const size_t e = args.find_last_not_of(" \t");
+  if (b == std::string::npos) {
+    OnLog({"$r[SSTDebug] Usage: find key | find key=value | find =value"});
+    return;
+  }
+  const std::string query = args.substr(b, e - b + 1);
+  const size_t eq = query.find('=');
+
+  // summarize the matches per component
+  struct Hits {
+    uint32_t component;
+    size_t count;
+    uint64_t first;
+    uint64_t last;
+  };
+  std::vector<Hits> hits;
+  std::vector<DebugMsg> messages;
+  {
+    std::lock_guard<std::mutex> lock(m_store_mutex);
+    auto start = chrono::steady_clock::now();
+    const DumpIndex::Postings &postings =
+        (eq == std::string::npos) ? Index.FindKey(query)
+        : (eq == 0)               ? Index.FindValue(query.substr(1))
+                    : Index.FindPair(query.substr(0, eq), query.substr(eq + 1));
+    const double usec =
+        chrono::duration<double, std::micro>(chrono::steady_clock::now() - start)
+            .count();
+    std::unordered_map<uint32_t, size_t> slot;
+    for (const auto &p : postings) {
+      auto it = slot.emplace(p.component, hits.size());
+      if (it.second) {
+        hits.push_back({p.component, 0, p.cycle, p.cycle});
+      }
+      Hits &h = hits[it.first->second];
+      h.count++;
+      h.first = std::min(h.first, p.cycle);
+      h.last = std::max(h.last, p.cycle);
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.1f", usec);
+    messages.push_back({"$b[SSTDebug] find " + query + ": " +
+                        std::to_string(postings.size()) + " matches in " +
+                        std::to_string(hits.size()) + " components (" + buffer +
+                        " us)"});
+    const size_t MaxLines = 64;
+    for (size_t i = 0; i < hits.size() && i < MaxLines; i++) {
+      const Hits &h = hits[i];
+      std::string cycles = (h.first == h.last)
+                               ? std::to_string(h.first)
+                               : std::to_string(h.first) + ".." +
+                                     std::to_string(h.last);
+      messages.push_back({"\t$g" + Index.Component(h.component) + "$w\t" +
+                          std::to_string(h.count) + " @ cycle " + cycles});
+    }
+    if (hits.size() > MaxLines) {
+      messages.push_back({"\t... " + std::to_string(hits.size() - MaxLines) +
+                          " more components"});
+    }
+  }
+  OnLogBatch(std::move(messages));
+}
+
+// Splits a command line into arguments; single and double quotes group
+static std::vector<std::string> SplitArgs(const std::string &line) {
+  std::vector<std::string> args;
+  std::string tok;
+  bool in_tok = false;
+  char quote = 0;
+  for (char c : line) {
+    if (quote) {
+      if (c == quote) {
+        quote = 0;
+      } else {
+        tok += c;
+      }
+    } else if (c == '"' || c == '\'') {
+      quote = c;
+      in_tok = true;
+    } else if (isspace((unsigned char)c)) {
+      if (in_tok) {
+        args.push_back(tok);
+      }
+      tok.clear();
+      in_tok = false;
+    } else {
+      tok += c;
+      in_tok = true;
+    }
+  }
+  if (in_tok) {
+    args.push_back(tok);
+  }
+  return args;
+}
+
 void DebugConsole::ExecuteCmd(std::string debug_shell_cmd) {
-  // std::string cmd_to_run = "sst-dbg --iter 1 -- sst ./2NodeTest_long.py > "
-  //                          "previous_sst_output.txt 2>&1";
+  // sst-dbg is executed directly; its output is read from a pipe and the
+  // dump events arrive over its live attach socket
+  std::vector<std::string> args = SplitArgs(debug_shell_cmd);
+  const auto sep = std::find(args.begin(), args.end(), "--");
+  const bool sweep = std::find_if(args.begin(), sep, [](const std::string &a) {
+                       return a == "--sweep" || a == "-sweep";
+                     }) != sep;
+
+  // sweeps run many jobs and cannot be attached; sst-dbg rejects --socket
+  std::string sock;
+  if (!sweep) {
+    sock = (std::filesystem::temp_directory_path() /
+            ("sst-dbg." + std::to_string(getpid()) + "." +
+             std::to_string(++RunCount) + ".sock"))
+               .string();
+    args.insert(args.begin(), {"--socket", sock});
+  }
+  args.insert(args.begin(), "sst-dbg");
+
+  std::string shown;
+  for (const auto &a : args) {
+    shown += (shown.empty() ? "" : " ") + a;
+  }
+  OnLog({shown});
+  if (sweep) {
+    OnLog({"$y[SSTDebug] Sweeps are not attached; dump events are not shown"});
+  }
+
+  // everything the child needs is built before the fork
+  std::vector<char *> argv;
+  for (auto &a : args) {
+    argv.push_back(&a[0]);
+  }
+  argv.push_back(nullptr);
 
-  std::string new_cmd =
-      "sst-dbg " + debug_shell_cmd + " > prev_sst_output.txt 2>&1";
+  int out[2];
+  if (pipe2(out, O_CLOEXEC) == -1) {
+    OnLog({"$r[SSTDebug] Unable to create a pipe for sst-dbg"});
+    sst_is_executing = false;
+    DebugCmd.clear();
+    return;
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    // the console keeps the terminal
+    int null = open("/dev/null", O_RDONLY);
+    if (null != -1) {
+      dup2(null, STDIN_FILENO);
+    }
+    dup2(out[1], STDOUT_FILENO);
+    dup2(out[1], STDERR_FILENO);
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+  close(out[1]);
+  if (pid == -1) {
+    close(out[0]);
+    OnLog({"$r[SSTDebug] Unable to start sst-dbg"});
+    sst_is_executing = false;
+    DebugCmd.clear();
+    return;
+  }
 
-  OnLog({new_cmd});
-  int result = std::system(new_cmd.c_str());
+  // the attach is abandoned as soon as sst-dbg exits (e.g., a rejected
+  // command line, whose error is then shown from the pipe)
+  std::atomic<bool> exited{false};
+  std::thread attacher;
+  if (!sweep) {
+    RunPiped = true;
+    attacher = std::thread([this, sock, &exited] {
+      for (unsigned waited = 0; waited <= 5000 && !exited; waited += 50) {
+        if (AttachLauncher(sock, 0)) {
+          return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+      if (!exited) {
+        OnLog({"$r[SSTDebug] Unable to attach to sst-dbg at " + sock});
+      }
+    });
+  }
+
+  char buf[4096];
+  std::string line;
+  ssize_t n;
+  while ((n = read(out[0], buf, sizeof(buf))) != 0) {
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (ssize_t i = 0; i < n; i++) {
+      if (buf[i] == '\n') {
+        OnLog({"$G" + line});
+        line.clear();
+      } else {
+        line += buf[i];
+      }
+    }
+  }
+  if (!line.empty()) {
+    OnLog({"$G" + line});
+  }
+  close(out[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {
+  }
+  exited = true;
+  if (attacher.joinable()) {
+    attacher.join();
+  }
+  RunPiped = false;
+  if (WIFEXITED(status) && WEXITSTATUS(status) == 127) {
+    OnLog({"$r[SSTDebug] Unable to execute sst-dbg"});
+  }
 
   sst_is_executing = false;
 
   DebugCmd.clear();
 }
 
+// ============================
+// DebugConsole::AttachLauncher
+// ============================
+bool DebugConsole::AttachLauncher(const std::string &Path, unsigned Timeout) {
+  std::unique_ptr<DebugSockClient> client(new DebugSockClient());
+  if (!client->Attach(
+          Path, [this](const std::string &Line) { OnLauncherLine(Line); },
+          [this, Path] { OnLog({"$y[sst-dbg] Connection closed: " + Path}); },
+          Timeout)) {
+    return false;
+  }
+
+  // the previous connection is closed outside the lock
+  std::unique_lock<std::mutex> lock(m_sock_mutex);
+  Launcher.swap(client);
+  lock.unlock();
+  client.reset();
+  return true;
+}
+
+// ============================
+// DebugConsole::DetachLauncher
+// ============================
+void DebugConsole::DetachLauncher() {
+  std::unique_ptr<DebugSockClient> client;
+  {
+    std::lock_guard<std::mutex> lock(m_sock_mutex);
+    client.swap(Launcher);
+  }
+  client.reset();
+}
+
+// ============================
+// DebugConsole::LauncherCommand
+// ============================
+void DebugConsole::LauncherCommand(const std::string &Cmd) {
+  std::lock_guard<std::mutex> lock(m_sock_mutex);
+  if (!Launcher || !Launcher->Send(Cmd)) {
+    OnLog({"$r[SSTDebug] Not attached to a running sst-dbg; use `run` or `attach`"});
+  }
+}
+
+// ============================
+// DebugConsole::OnLauncherLine
+// --> Called from the socket reader thread
+// ============================
+void DebugConsole::OnLauncherLine(const std::string &Line) {
+  const size_t sp = Line.find(' ');
+  const std::string op = Line.substr(0, sp);
+  const std::string rest = (sp == std::string::npos) ? "" : Line.substr(sp + 1);
+
+  if (op == "OUT") {
+    // the output of a run started here is read from its pipe
+    if (!RunPiped) {
+      OnLog({"$G" + rest});
+    }
+  } else if (op == "DUMP") {
+    OnLog({"$y[sst-dbg] Dump " + rest});
+  } else if (op == "DONE") {
+    std::istringstream ss(rest);
+    std::string n, files, bytes, secs;
+    ss >> n >> files >> bytes >> secs;
+    OnLog({"$g[sst-dbg] Dump " + n + " complete : " + files + " files, " +
+           bytes + " bytes in " + secs + " s"});
+  } else if (op == "HELLO") {
+    OnLog({"$g[sst-dbg] Attached to SST pid " + rest.substr(0, rest.find(' '))});
+  } else if (op == "EXIT") {
+    OnLog({"$y[sst-dbg] SST exited with status " + rest});
+  } else if (op == "ERR") {
+    OnLog({"$r[sst-dbg] " + rest});
+  } else {
+    OnLog({"$b[sst-dbg] " + Line});
+  }
+}
+
 void DebugConsole::WatcherThread() {
   std::unique_lock<std::mutex> lock(m_sstMutex);
   cv.wait(lock, [this] {
@@ -437,11 +995,33 @@ void DebugConsole::ConsumeCommand() {
     return;
   } else if (userInput == "help") {
     PrintHelp();
+  } else if (GetCommandName() == "table") {
+    TableCommand(userInput.substr(5));
+  } else if (GetCommandName() == "pin" || GetCommandName() == "unpin") {
+    PinCommand(GetCommandName() == "pin" ? userInput.substr(3) : "");
+  } else if (GetCommandName() == "plot") {
+    PlotCommand(userInput.substr(4));
+  } else if (GetCommandName() == "attach") {
+    std::istringstream ss(userInput.substr(6));
+    std::string path;
+    ss >> path;
+    if (path.empty()) {
+      OnLog({"$r[SSTDebug] Usage: attach /path/to/socket"});
+    } else if (!AttachLauncher(path, 0)) {
+      OnLog({"$r[SSTDebug] Unable to attach to sst-dbg at " + path});
+    }
+  } else if (GetCommandName() == "detach") {
+    DetachLauncher();
+  } else if (GetCommandName() == "dump" || GetCommandName() == "pause" ||
+             GetCommandName() == "resume" || GetCommandName() == "interval" ||
+             GetCommandName() == "status") {
+    LauncherCommand(userInput);
+  } else if (GetCommandName() == "find") {
+    FindCommand(userInput.substr(4));
   } else if (userInput.find("!") == 0) {
-    std::unique_lock<std::mutex> lock(m_msg_mutex);
+    // the message lock is not held here; the renderer needs it per row
     std::string shellCmd = userInput.erase(userInput.find('!'), 1);
     std::system(shellCmd.c_str());
-    lock.unlock();
     std::this_thread::sleep_for(chrono::seconds(2));
   } else if (userInput.find("ls") != std::string::npos) {
     // std::unique_lock<std::mutex> lock(m_msg_mutex);
@@ -8,6 +8,7 @@
 // See LICENSE in the top level directory for licensing details
 //
 
+#include <atomic>
 #include <condition_variable>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/component_base.hpp>
@@ -22,6 +23,11 @@ using namespace ftxui;
 
 #include "./Scroller.h"
 #include "./DebugMsg.h"
+#include "./MsgLog.h"
+#include "./DumpStore.h"
+#include "./DumpIndex.h"
+#include "../SSTDebugParse.h"
+#include "../SSTDebugSock.h"
 
 // ============
 // DebugConsole
@@ -32,6 +38,8 @@ public:
   void Shutdown();
 
   void OnLog( const DebugMsg& message );
+  void OnLogBatch( std::vector<DebugMsg>&& messages );
+  void OnDumpRecords( std::vector<DumpRecord>&& records );
   bool OnUpdate( const float& deltaTime );
   
   bool WriteHistory( const std::string& Filename );
@@ -59,18 +67,55 @@ private:
   bool IsInputValid() const;
   std::string GetCommandName() const;
 
-  static const char* GenerateTimeString( const DebugMsg& message );
+  static Color SpanColor( char code );
   static Element DebugMsgToFtxElement( const DebugMsg& message );
 
+  // Table view
+  void TableCommand( const std::string& args );
+  void PinCommand( const std::string& args );
+  std::vector<size_t> TableColumns() const;
+  int TableRowCount();
+  Element TableHeader();
+  Element TableRow( int i );
+  Element TableView();
+
+  // Plot view
+  void PlotCommand( const std::string& args );
+  Element PlotView();
+
+  // Search
+  void FindCommand( const std::string& args );
+
   void ExecuteCmd(std::string debug_shell_cmd);
 
   void WatcherThread();
 
+  // Live attach to a running sst-dbg
+  bool AttachLauncher( const std::string& Path, unsigned Timeout );
+  void DetachLauncher();
+  void LauncherCommand( const std::string& Cmd );
+  void OnLauncherLine( const std::string& Line );
+
   private:
     bool Exited;
     std::filesystem::path DumpDirectory;
     bool stopListening{ false };
-    std::vector<DebugMsg> MsgQueue{};
+    MsgLog MsgQueue{};
+
+    // Dumped values; components x variables
+    std::mutex m_store_mutex;
+    DumpStore Store{};
+    DumpIndex Index{};
+    int ViewTab{ 0 };                     // 0: message log, 1: table, 2: plot
+    std::vector<std::string> TableVars{}; // selected columns; empty = all
+    std::string PinnedComponent{ "" };    // history view of one component
+    std::string PlotComp{ "" };           // plotted component
+    std::string PlotVar{ "" };            // plotted variable
+
+    std::mutex m_sock_mutex;
+    std::unique_ptr<DebugSockClient> Launcher{};
+    unsigned RunCount{ 0 };
+    std::atomic<bool> RunPiped{ false };  // is a run's output read from its pipe?
 
     std::thread ListenerThread;
     float TimeToUpdate{ 0.1f };
@@ -86,8 +131,9 @@ private:
     // Title Bar
     Component TitleComponent{};
     Component InputFieldComponent{};
-    Component MsgFrameComponent{};
     Component MsgScrollerComponent{};
+    Component TableScrollerComponent{};
+    Component PlotComponent{};
 
     Component MainContainerComponent{}; // Includes MsgFrameComponent & InputFieldComponent
     Component MainComponent{};
@@ -8,9 +8,60 @@
 // See LICENSE in the top level directory for licensing details
 //
 
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
 #include <string>
+#include <vector>
+
+// A run of `text` drawn in a single colour
+struct DebugSpan {
+  char color;
+  uint32_t offset;
+  uint32_t length;
+};
 
 struct DebugMsg {
   std::string text;
   float timeSubmitted = 0.0f;
+
+  // Filled in once by Parse(); read-only afterwards
+  std::vector<DebugSpan> spans{};
+  std::string timeString{};
+
+  // Splits `text` at its `$x` colour escapes and formats the timestamp
+  // so rendering does not re-scan the message on every frame
+  void Parse() {
+    spans.clear();
+    char currentColor = 'w';
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      if (text[i] != '$') {
+        continue;
+      }
+      if (i > start) {
+        spans.push_back({currentColor, uint32_t(start), uint32_t(i - start)});
+      }
+      if (i + 1 >= text.size()) {
+        start = text.size();
+        break;
+      }
+      currentColor = text[++i];
+      start = i + 1;
+    }
+    if (start < text.size()) {
+      spans.push_back(
+          {currentColor, uint32_t(start), uint32_t(text.size() - start)});
+    }
+
+    // mmm:ss.ssss
+    char buffer[16];
+    const int iTime = timeSubmitted;
+    const int seconds = int(timeSubmitted) % 60;
+    const int minutes = iTime / 60;
+    const float flSeconds = seconds + (timeSubmitted - iTime);
+    snprintf(buffer, sizeof(buffer), "%03i:%06.3f ", minutes, flSeconds);
+    timeString = buffer;
+  }
 };
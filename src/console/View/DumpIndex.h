@@ -0,0 +1,108 @@
+//
+// _DumpIndex_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../SSTDebugParse.h"
+
+// ============
+// DumpIndex
+// ============
+// Inverted index over every ingested dump record.  Keys, values and
+// key=value pairs each map to the list of (component, cycle) postings in
+// which they occur, so a lookup is a single hash probe regardless of the
+// number of records loaded.
+class DumpIndex final {
+public:
+  struct Posting {
+    uint32_t component;
+    uint64_t cycle;
+  };
+  using Postings = std::vector<Posting>;
+
+  void Add(const DumpRecord &record) {
+    if (!record.valid || record.component.empty())
+      return;
+
+    const Posting p{InternComponent(record.component), record.cycle};
+    for (const auto &value : record.values) {
+      Append(m_keys[value.first], p);
+      Append(m_values[value.second], p);
+      Append(m_pairs[PairKey(value.first, value.second)], p);
+    }
+    m_records++;
+  }
+
+  // Postings of every record holding `key`
+  const Postings &FindKey(const std::string &key) const {
+    return Lookup(m_keys, key);
+  }
+
+  // Postings of every record holding any key with `value`
+  const Postings &FindValue(const std::string &value) const {
+    return Lookup(m_values, value);
+  }
+
+  // Postings of every record holding `key` with `value`
+  const Postings &FindPair(const std::string &key, const std::string &value) const {
+    return Lookup(m_pairs, PairKey(key, value));
+  }
+
+  const std::string &Component(uint32_t id) const { return m_components[id]; }
+
+  // Number of records indexed
+  uint64_t Records() const { return m_records; }
+
+private:
+  using Map = std::unordered_map<std::string, Postings>;
+
+  static std::string PairKey(const std::string &key, const std::string &value) {
+    std::string k;
+    k.reserve(key.size() + value.size() + 1);
+    k.append(key).push_back('\0');
+    k.append(value);
+    return k;
+  }
+
+  // a record lists each key once, but a value may repeat across keys
+  static void Append(Postings &list, const Posting &p) {
+    if (list.empty() || list.back().component != p.component ||
+        list.back().cycle != p.cycle)
+      list.push_back(p);
+  }
+
+  const Postings &Lookup(const Map &map, const std::string &k) const {
+    auto it = map.find(k);
+    return it == map.end() ? m_none : it->second;
+  }
+
+  uint32_t InternComponent(const std::string &name) {
+    auto it = m_component_ids.find(name);
+    if (it != m_component_ids.end())
+      return it->second;
+    const uint32_t id = uint32_t(m_components.size());
+    m_component_ids.emplace(name, id);
+    m_components.push_back(name);
+    return id;
+  }
+
+  Map m_keys;
+  Map m_values;
+  Map m_pairs;
+  std::vector<std::string> m_components;
+  std::unordered_map<std::string, uint32_t> m_component_ids;
+  uint64_t m_records{0};
+  const Postings m_none{};
+};
@@ -0,0 +1,201 @@
+//
+// _DumpStore_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../SSTDebugParse.h"
+#include "./MinMaxSeries.h"
+
+// ============
+// DumpStore
+// ============
+// Columnar store of the dumped values.  Components are rows and variables
+// are columns; each column holds the value of every component at its
+// latest cycle.  Every component additionally keeps a bounded history
+// with one column per variable, aligned with its list of cycles.  Adding
+// a record only touches the cells of the record's component.
+class DumpStore final {
+public:
+  static constexpr size_t HistoryLimit = 1024; // cycles kept per component
+  static constexpr size_t MaxWidth = 32;       // widest column, in chars
+
+  void Add(const DumpRecord &record) {
+    if (!record.valid || record.component.empty())
+      return;
+
+    const size_t row = InternComponent(record.component);
+    History &hist = m_history[row];
+
+    // cycles are usually appended; out-of-order dumps are inserted and
+    // a second record for a cycle is merged into the first
+    auto it = std::lower_bound(hist.cycles.begin(), hist.cycles.end(),
+                               record.cycle);
+    const size_t pos = size_t(it - hist.cycles.begin());
+    if (it == hist.cycles.end() || *it != record.cycle) {
+      hist.cycles.insert(it, record.cycle);
+      for (auto &column : hist.columns)
+        if (pos < column.size())
+          column.insert(column.begin() + pos, std::string{});
+    }
+
+    const bool latest = (m_cycle[row] <= record.cycle) || !m_seen[row];
+    if (latest) {
+      m_cycle[row] = record.cycle;
+      m_seen[row] = true;
+    }
+
+    for (const auto &value : record.values) {
+      const size_t col = InternVar(value.first);
+      if (hist.columns.size() <= col)
+        hist.columns.resize(col + 1);
+      auto &column = hist.columns[col];
+      if (column.size() <= pos)
+        column.resize(pos + 1);
+      column[pos] = value.second;
+
+      if (latest)
+        m_latest[col][row] = value.second;
+      AppendSeries(row, col, record.cycle, value.second);
+      m_width[col] = std::min(MaxWidth, std::max(m_width[col], value.second.size()));
+    }
+
+    if (hist.cycles.size() > HistoryLimit) {
+      hist.cycles.pop_front();
+      for (auto &column : hist.columns)
+        if (!column.empty())
+          column.pop_front();
+    }
+  }
+
+  // -- components (rows)
+  size_t NumComponents() const { return m_components.size(); }
+  const std::string &Component(size_t row) const { return m_components[row]; }
+  int FindComponent(const std::string &name) const {
+    auto it = m_component_ids.find(name);
+    return it == m_component_ids.end() ? -1 : int(it->second);
+  }
+  uint64_t LatestCycle(size_t row) const { return m_cycle[row]; }
+
+  // -- variables (columns)
+  size_t NumVars() const { return m_vars.size(); }
+  const std::string &Var(size_t col) const { return m_vars[col]; }
+  int FindVar(const std::string &name) const {
+    auto it = m_var_ids.find(name);
+    return it == m_var_ids.end() ? -1 : int(it->second);
+  }
+  size_t Width(size_t col) const { return m_width[col]; }
+
+  // Value of a variable at the component's latest cycle
+  const std::string &Latest(size_t row, size_t col) const {
+    return m_latest[col][row];
+  }
+
+  // -- per-component history
+  size_t HistorySize(size_t row) const { return m_history[row].cycles.size(); }
+  uint64_t HistoryCycle(size_t row, size_t h) const {
+    return m_history[row].cycles[h];
+  }
+  const std::string &HistoryValue(size_t row, size_t h, size_t col) const {
+    const History &hist = m_history[row];
+    if (col >= hist.columns.size() || h >= hist.columns[col].size())
+      return m_empty;
+    return hist.columns[col][h];
+  }
+
+  // -- numeric series
+  // Starts tracking a variable of a component as a downsampled series,
+  // seeded from its history; later records are appended as they arrive
+  const MinMaxSeries &Track(size_t row, size_t col) {
+    auto it = m_series.find(SeriesKey(row, col));
+    if (it != m_series.end())
+      return it->second;
+    MinMaxSeries &series = m_series[SeriesKey(row, col)];
+    for (size_t h = 0; h < HistorySize(row); h++) {
+      double v;
+      if (MinMaxSeries::ToNumber(HistoryValue(row, h, col), v))
+        series.Append(HistoryCycle(row, h), v);
+    }
+    return series;
+  }
+
+private:
+  static uint64_t SeriesKey(size_t row, size_t col) {
+    return (uint64_t(row) << 32) | uint64_t(col);
+  }
+
+  void AppendSeries(size_t row, size_t col, uint64_t cycle,
+                    const std::string &value) {
+    if (m_series.empty())
+      return;
+    auto it = m_series.find(SeriesKey(row, col));
+    double v;
+    // out-of-order cycles are left out of the series
+    if (it != m_series.end() &&
+        (it->second.Empty() || cycle > it->second.LastCycle()) &&
+        MinMaxSeries::ToNumber(value, v))
+      it->second.Append(cycle, v);
+  }
+
+  struct History {
+    std::deque<uint64_t> cycles;
+    // indexed by variable; a column may be shorter than `cycles`, the
+    // missing trailing cells are empty
+    std::vector<std::deque<std::string>> columns;
+  };
+
+  size_t InternComponent(const std::string &name) {
+    auto it = m_component_ids.find(name);
+    if (it != m_component_ids.end())
+      return it->second;
+    const size_t row = m_components.size();
+    m_component_ids.emplace(name, row);
+    m_components.push_back(name);
+    m_cycle.push_back(0);
+    m_seen.push_back(false);
+    m_history.emplace_back();
+    for (auto &column : m_latest)
+      column.emplace_back();
+    return row;
+  }
+
+  size_t InternVar(const std::string &name) {
+    auto it = m_var_ids.find(name);
+    if (it != m_var_ids.end())
+      return it->second;
+    const size_t col = m_vars.size();
+    m_var_ids.emplace(name, col);
+    m_vars.push_back(name);
+    m_width.push_back(std::min(MaxWidth, name.size()));
+    m_latest.emplace_back(m_components.size());
+    return col;
+  }
+
+  std::vector<std::string> m_components;
+  std::unordered_map<std::string, size_t> m_component_ids;
+  std::vector<uint64_t> m_cycle;  // latest cycle of each component
+  std::vector<bool> m_seen;       // has the component been dumped?
+  std::vector<History> m_history; // per component
+
+  std::vector<std::string> m_vars;
+  std::unordered_map<std::string, size_t> m_var_ids;
+  std::vector<size_t> m_width;                   // per variable
+  std::vector<std::vector<std::string>> m_latest; // [variable][component]
+
+  std::unordered_map<uint64_t, MinMaxSeries> m_series; // tracked variables
+
+  const std::string m_empty{};
+};
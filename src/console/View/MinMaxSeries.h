@@ -0,0 +1,110 @@
+//
+// _MinMaxSeries_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// ============
+// MinMaxSeries
+// ============
+// Downsampled series of (cycle, value) points.  Points are accumulated in
+// at most `Buckets` buckets that each keep the min, max, first and last
+// value of the points they cover.  When every bucket is full, adjacent
+// buckets are merged pairwise and each bucket covers twice as many points,
+// so an append is O(1) amortized and the series never grows past
+// `Buckets` entries however long the run is.
+class MinMaxSeries final {
+public:
+  struct Bucket {
+    uint64_t first_cycle;
+    uint64_t last_cycle;
+    double min;
+    double max;
+    double first;
+    double last;
+  };
+
+  explicit MinMaxSeries(size_t Buckets = 512)
+      : m_limit(std::max<size_t>(2, Buckets & ~size_t(1))) {
+    m_buckets.reserve(m_limit);
+  }
+
+  // Parses `value` as a number; returns false for non-numeric values
+  static bool ToNumber(const std::string &value, double &out) {
+    if (value.empty())
+      return false;
+    char *end = nullptr;
+    out = std::strtod(value.c_str(), &end);
+    return end == value.c_str() + value.size();
+  }
+
+  void Append(uint64_t cycle, double value) {
+    if (m_buckets.empty() || m_fill == m_span) {
+      if (m_buckets.size() == m_limit)
+        Merge();
+      m_buckets.push_back({cycle, cycle, value, value, value, value});
+      m_fill = 1;
+    } else {
+      Bucket &b = m_buckets.back();
+      b.last_cycle = cycle;
+      b.min = std::min(b.min, value);
+      b.max = std::max(b.max, value);
+      b.last = value;
+      m_fill++;
+    }
+    m_points++;
+  }
+
+  const std::vector<Bucket> &Buckets() const { return m_buckets; }
+  uint64_t Points() const { return m_points; }
+  bool Empty() const { return m_buckets.empty(); }
+  uint64_t LastCycle() const {
+    return m_buckets.empty() ? 0 : m_buckets.back().last_cycle;
+  }
+
+  double Min() const {
+    double m = m_buckets.empty() ? 0. : m_buckets.front().min;
+    for (const auto &b : m_buckets)
+      m = std::min(m, b.min);
+    return m;
+  }
+
+  double Max() const {
+    double m = m_buckets.empty() ? 0. : m_buckets.front().max;
+    for (const auto &b : m_buckets)
+      m = std::max(m, b.max);
+    return m;
+  }
+
+private:
+  // halves the number of buckets; only happens once per `m_span` points
+  void Merge() {
+    for (size_t i = 0; i < m_buckets.size() / 2; i++) {
+      const Bucket &a = m_buckets[2 * i];
+      const Bucket &b = m_buckets[2 * i + 1];
+      m_buckets[i] = {a.first_cycle,          b.last_cycle,
+                      std::min(a.min, b.min), std::max(a.max, b.max),
+                      a.first,                b.last};
+    }
+    m_buckets.resize(m_buckets.size() / 2);
+    m_span *= 2;
+  }
+
+  size_t m_limit;          // maximum number of buckets
+  size_t m_span{1};        // points per full bucket
+  size_t m_fill{0};        // points in the last bucket
+  uint64_t m_points{0};    // points appended
+  std::vector<Bucket> m_buckets;
+};
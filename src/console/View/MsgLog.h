@@ -0,0 +1,164 @@
+//
+// _MsgLog_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "./DebugMsg.h"
+
+// ============
+// MsgLog
+// ============
+// Bounded message log.  The most recent `Capacity` messages are kept in an
+// in-memory ring; older messages are spilled to an anonymous append-only
+// file and paged back in (a page of records at a time) when they are
+// scrolled into view.  Memory use is bound by the ring, a small page cache
+// and a sparse index holding one file offset per page.
+class MsgLog final {
+public:
+  explicit MsgLog(size_t Capacity = 1 << 16)
+      : m_capacity(Capacity ? Capacity : 1) {
+    m_ring.reserve(m_capacity);
+    m_spill = std::tmpfile();
+  }
+
+  ~MsgLog() {
+    if (m_spill)
+      std::fclose(m_spill);
+  }
+
+  MsgLog(const MsgLog &) = delete;
+  MsgLog &operator=(const MsgLog &) = delete;
+
+  // Total number of messages, resident and spilled
+  size_t size() const { return m_spilled + m_ring.size(); }
+
+  // Number of messages currently held in memory
+  size_t resident() const { return m_ring.size(); }
+
+  void push_back(DebugMsg message) {
+    if (m_ring.size() < m_capacity) {
+      m_ring.push_back(std::move(message));
+      return;
+    }
+
+    // the ring is full: spill the oldest message and reuse its slot
+    Spill(m_ring[m_start]);
+    m_ring[m_start] = std::move(message);
+    m_start = (m_start + 1) % m_capacity;
+  }
+
+  // Returns message `i`; the reference is valid until the next call
+  const DebugMsg &at(size_t i) {
+    if (i >= m_spilled)
+      return m_ring[(m_start + (i - m_spilled)) % m_capacity];
+    const std::vector<DebugMsg> &Page = LoadPage(i / PageSize);
+    if ((i % PageSize) < Page.size())
+      return Page[i % PageSize];
+    return m_missing;
+  }
+
+private:
+  static constexpr size_t PageSize = 1024;   // records per spill page
+  static constexpr size_t PageCacheSize = 8; // pages kept in memory
+
+  void Spill(const DebugMsg &message) {
+    if (m_spill == nullptr) {
+      // no spill file; the history is dropped
+      m_spilled++;
+      return;
+    }
+
+    if (m_reading) {
+      std::fseek(m_spill, 0, SEEK_END);
+      m_reading = false;
+    }
+    if ((m_spilled % PageSize) == 0)
+      m_index.push_back(m_end);
+
+    uint32_t Len = uint32_t(message.text.size());
+    std::fwrite(&message.timeSubmitted, sizeof(message.timeSubmitted), 1, m_spill);
+    std::fwrite(&Len, sizeof(Len), 1, m_spill);
+    std::fwrite(message.text.data(), 1, Len, m_spill);
+    m_end += sizeof(message.timeSubmitted) + sizeof(Len) + Len;
+    m_spilled++;
+
+    // the page being appended to may be cached; drop it
+    size_t Page = (m_spilled - 1) / PageSize;
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+      if (it->first == Page) {
+        m_cache.erase(it);
+        break;
+      }
+    }
+  }
+
+  const std::vector<DebugMsg> &LoadPage(size_t Page) {
+    // most recently used pages are kept at the front
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+      if (it->first == Page) {
+        m_cache.splice(m_cache.begin(), m_cache, it);
+        return m_cache.front().second;
+      }
+    }
+
+    if (m_cache.size() >= PageCacheSize)
+      m_cache.pop_back();
+    m_cache.emplace_front(Page, std::vector<DebugMsg>{});
+    std::vector<DebugMsg> &Records = m_cache.front().second;
+
+    if (m_spill == nullptr || Page >= m_index.size())
+      return Records;
+
+    std::fflush(m_spill);
+    std::fseek(m_spill, long(m_index[Page]), SEEK_SET);
+    m_reading = true;
+
+    const size_t Count = std::min(PageSize, m_spilled - Page * PageSize);
+    Records.reserve(Count);
+    for (size_t i = 0; i < Count; i++) {
+      DebugMsg Msg;
+      uint32_t Len = 0;
+      if (std::fread(&Msg.timeSubmitted, sizeof(Msg.timeSubmitted), 1, m_spill) != 1 ||
+          std::fread(&Len, sizeof(Len), 1, m_spill) != 1)
+        break;
+      Msg.text.resize(Len);
+      if (Len && std::fread(&Msg.text[0], 1, Len, m_spill) != Len)
+        break;
+      Msg.Parse();
+      Records.push_back(std::move(Msg));
+    }
+    return Records;
+  }
+
+  size_t m_capacity;
+  std::vector<DebugMsg> m_ring;   // resident messages
+  size_t m_start{0};              // ring slot of the oldest resident message
+  size_t m_spilled{0};            // number of spilled messages
+  std::FILE *m_spill{nullptr};    // spill file
+  uint64_t m_end{0};              // spill file size
+  bool m_reading{false};          // was the last spill file operation a read?
+  std::vector<uint64_t> m_index;  // spill file offset of each page
+  std::list<std::pair<size_t, std::vector<DebugMsg>>> m_cache;
+  DebugMsg m_missing = Missing();
+
+  static DebugMsg Missing() {
+    DebugMsg Msg{"$r[history unavailable]"};
+    Msg.Parse();
+    return Msg;
+  }
+};
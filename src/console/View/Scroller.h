@@ -13,6 +13,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <ftxui/screen/terminal.hpp>
+
 namespace ftxui
 {
 	class ScrollerBase : public ComponentBase
@@ -77,6 +81,111 @@ namespace ftxui
 	{
 		return Make<ScrollerBase>( std::move( child ) );
 	}
+
+	// VirtualScroller: only the visible window of rows is converted into
+	// elements.  Rows are produced on demand by `row( index )` and the scroll
+	// extent is computed from `count()`, so the cost of a frame is bound by
+	// the height of the view rather than by the number of rows.
+	class VirtualScrollerBase : public ComponentBase
+	{
+	public:
+		VirtualScrollerBase( std::function<int()> count, std::function<Element( int )> row )
+			: count_( std::move( count ) ), row_( std::move( row ) ) {}
+
+	private:
+		Element Render() final
+		{
+			size_ = std::max( 0, count_() );
+			height_ = box_.y_max - box_.y_min + 1;
+			if ( height_ <= 1 )
+				height_ = Terminal::Size().dimy; // first frame, the box is not laid out yet
+
+			Clamp();
+
+			Elements rows;
+			const int last = std::min( size_, first_ + height_ );
+			for ( int i = first_; i < last; i++ )
+				rows.push_back( row_( i ) );
+
+			return hbox( {
+					   vbox( std::move( rows ) ) | yframe | flex,
+					   Indicator(),
+				} ) |
+				yflex | reflect( box_ );
+		}
+
+		// Scrollbar drawn from the row count; one element per visible line
+		Element Indicator() const
+		{
+			if ( size_ <= height_ )
+				return text( L" " );
+
+			const int thumb = std::max( 1, height_ * height_ / size_ );
+			const int start = (int)( (long long)( height_ - thumb ) * first_ / std::max( 1, size_ - height_ ) );
+			Elements bar;
+			for ( int i = 0; i < height_; i++ )
+				bar.push_back( text( ( i >= start && i < start + thumb ) ? L"┃" : L"│" ) );
+			return vbox( std::move( bar ) );
+		}
+
+		void Clamp()
+		{
+			const int bottom = std::max( 0, size_ - height_ );
+			if ( follow_ )
+				first_ = bottom;
+			first_ = std::max( 0, std::min( bottom, first_ ) );
+			follow_ = ( first_ == bottom );
+		}
+
+		bool OnEvent( Event event ) final
+		{
+			if ( event.is_mouse() && box_.Contain( event.mouse().x, event.mouse().y ) )
+				TakeFocus();
+
+			int first_old = first_;
+			bool follow_old = follow_;
+			if ( event == Event::ArrowUp || event == Event::Character( 'k' ) ||
+				(event.is_mouse() && event.mouse().button == Mouse::WheelUp) ) {
+				first_--;
+				follow_ = false;
+			}
+			if ( (event == Event::ArrowDown || event == Event::Character( 'j' ) ||
+				(event.is_mouse() && event.mouse().button == Mouse::WheelDown)) ) {
+				first_++;
+			}
+			if ( event == Event::PageDown )
+				first_ += height_;
+			if ( event == Event::PageUp ) {
+				first_ -= height_;
+				follow_ = false;
+			}
+			if ( event == Event::Home ) {
+				first_ = 0;
+				follow_ = false;
+			}
+			if ( event == Event::End )
+				follow_ = true;
+
+			size_ = std::max( 0, count_() );
+			Clamp();
+			return first_old != first_ || follow_old != follow_;
+		}
+
+		bool Focusable() const final { return false; }
+
+		std::function<int()> count_;
+		std::function<Element( int )> row_;
+		int first_ = 0;     // first visible row
+		int size_ = 0;      // number of rows at the last frame
+		int height_ = 0;    // visible rows at the last frame
+		bool follow_ = true; // stick to the newest row
+		Box box_;
+	};
+
+	inline Component VirtualScroller( std::function<int()> count, std::function<Element( int )> row )
+	{
+		return Make<VirtualScrollerBase>( std::move( count ), std::move( row ) );
+	}
 }  // namespace ftxui
 
 // Copyright 2021 Arthur Sonzogni. All rights reserved.
@@ -13,8 +13,11 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <deque>
+#include <memory>
 #include <thread>
 #include <chrono>
+#include <atomic>
 #include <cstring>
 #include <errno.h>
 #include <stdio.h>
@@ -25,20 +28,55 @@
 #include <sys/wait.h>
 #include <sys/types.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <poll.h>
+
+#include "SSTDebugStats.h"
+#include "SSTDebugTrigger.h"
+#include "SSTDebugRetain.h"
+#include "SSTDebugSock.h"
 
 typedef struct{
   bool isHelp;
   bool isOneShot;
   bool isIter;
   bool isRand;
+  bool isStats;
   unsigned sec;
+  unsigned Cores;
+  unsigned JobCores;
+  unsigned StatusSec;
+  unsigned RSS;
+  unsigned Keep;
+  unsigned KeepMB;
+  unsigned ForkMax;
+  double Stall;
+  double Debounce;
   unsigned ArgC;
   pid_t pid;
   std::string SSTArgs;
   std::string SSTPath;
+  std::string DumpDir;
+  std::string Report;
+  std::string Sweep;
+  std::string Socket;
+  std::string EpochFile;
+  std::vector<std::string> Watch;
 }CLICONF;
 
+typedef struct{
+  DumpStats *Stats;       // dump overhead instrumentation
+  DumpTriggers *Triggers; // condition-triggered dumps
+  std::ostream *Log;      // launcher message stream
+  unsigned Dumps;         // number of dumps triggered
+  DebugSockServer *Sock;  // live attach socket
+  bool Paused;            // child stopped from an attached console
+  uint64_t *Epoch;        // trigger generation shared with SSTDebug (fork mode)
+}MONITORS;
+
 void PrintHelp(){
   std::cout << " Usage: sst-dbg [OPTIONS] -- /path/to/sst arg1 arg2 arg3 ..." << std::endl;
   std::cout << " Options:" << std::endl;
@@ -46,6 +84,21 @@ void PrintHelp(){
   std::cout << "\t-i|-iter|--iter sec         : Dump the state every `sec` seconds" << std::endl;
   std::cout << "\t-o|-oneshot|--oneshot sec   : Perform a single dump at time=`sec`" << std::endl;
   std::cout << "\t-r|-rand|--rand             : Dump the state on a random cadence between 0-60 seconds" << std::endl;
+  std::cout << "\t-d|-dir|--dir path         : Directory where the dump files are written (default ./)" << std::endl;
+  std::cout << "\t-s|-stats|--stats          : Print a dump overhead summary at exit" << std::endl;
+  std::cout << "\t-report|--report file      : Export the dump overhead records to file (.csv or .json)" << std::endl;
+  std::cout << "\t-k|-keep|--keep N           : Retain only the last `N` dumps of each component" << std::endl;
+  std::cout << "\t-keep-mb|--keep-mb MB      : Retain at most `MB` megabytes of dumps per component" << std::endl;
+  std::cout << "\t-f|-fork|--fork N           : Enable forked snapshot dumps with at most `N` concurrent snapshots" << std::endl;
+  std::cout << "\t-sweep|--sweep file         : Run each SST command line in `file` concurrently" << std::endl;
+  std::cout << "\t-cores|--cores N           : Sweep core budget (default: all available cores)" << std::endl;
+  std::cout << "\t-job-cores|--job-cores N   : Cores pinned to each sweep job (default 1)" << std::endl;
+  std::cout << "\t-status|--status sec       : Sweep status interval in seconds (default 10)" << std::endl;
+  std::cout << "\t-rss|--rss MB              : Dump when the SST resident set size exceeds `MB` megabytes" << std::endl;
+  std::cout << "\t-stall|--stall sec         : Dump when the SST CPU time has not advanced for `sec` seconds" << std::endl;
+  std::cout << "\t-w|-watch|--watch regex    : Dump when a line of SST output matches `regex`" << std::endl;
+  std::cout << "\t-debounce|--debounce sec   : Minimum seconds between condition-triggered dumps (default 10)" << std::endl;
+  std::cout << "\t-socket|--socket path      : Accept live console connections on the Unix socket `path`" << std::endl;
 }
 
 void SplitStr(const std::string& s, char delim,
@@ -85,6 +138,8 @@ bool SetupSSTArgs(CLICONF &Conf){
     Input.open(name);
     std::getline(Input,Conf.SSTPath);
     Input.close();
+    close(fd);
+    unlink(name);
   }else{
     // the first arg should be the full path
     // ensure that 'sst' appears in the string
@@ -116,8 +171,19 @@ bool ParseArgs(int argc, char **argv, CLICONF &Conf){
   Conf.isOneShot  = false;
   Conf.isIter     = false;
   Conf.isRand     = false;
+  Conf.isStats    = false;
   Conf.sec        = 0;
   Conf.ArgC       = 2;
+  Conf.DumpDir    = "./";
+  Conf.RSS        = 0;
+  Conf.Cores      = 0;
+  Conf.JobCores   = 1;
+  Conf.StatusSec  = 10;
+  Conf.Keep       = 0;
+  Conf.KeepMB     = 0;
+  Conf.ForkMax    = 0;
+  Conf.Stall      = 0.;
+  Conf.Debounce   = 10.;
 
   for( int i=1; i<argc; i++ ){
     std::string s(argv[i]);
@@ -171,6 +237,116 @@ bool ParseArgs(int argc, char **argv, CLICONF &Conf){
       Conf.sec = (unsigned)(rand()%60);
       if( Conf.sec == 0 )
         Conf.sec++;
+    }else if( (s=="-d") || (s=="-dir") || (s=="--dir") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --dir requires an argument" << std::endl;
+        return false;
+      }
+      Conf.DumpDir = std::string(argv[i+1]);
+      i++;
+    }else if( (s=="-s") || (s=="-stats") || (s=="--stats") ){
+      Conf.isStats = true;
+    }else if( (s=="-report") || (s=="--report") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --report requires an argument" << std::endl;
+        return false;
+      }
+      Conf.isStats = true;
+      Conf.Report  = std::string(argv[i+1]);
+      i++;
+    }else if( (s=="-k") || (s=="-keep") || (s=="--keep") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --keep requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.Keep = stoi(P);
+      i++;
+    }else if( (s=="-keep-mb") || (s=="--keep-mb") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --keep-mb requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.KeepMB = stoi(P);
+      i++;
+    }else if( (s=="-f") || (s=="-fork") || (s=="--fork") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --fork requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.ForkMax = stoi(P);
+      i++;
+    }else if( (s=="-sweep") || (s=="--sweep") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --sweep requires an argument" << std::endl;
+        return false;
+      }
+      Conf.Sweep = std::string(argv[i+1]);
+      i++;
+    }else if( (s=="-cores") || (s=="--cores") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --cores requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.Cores = stoi(P);
+      i++;
+    }else if( (s=="-job-cores") || (s=="--job-cores") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --job-cores requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.JobCores = stoi(P);
+      i++;
+    }else if( (s=="-status") || (s=="--status") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --status requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.StatusSec = stoi(P);
+      i++;
+    }else if( (s=="-rss") || (s=="--rss") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --rss requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.RSS = stoi(P);
+      i++;
+    }else if( (s=="-stall") || (s=="--stall") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --stall requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.Stall = stod(P);
+      i++;
+    }else if( (s=="-w") || (s=="-watch") || (s=="--watch") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --watch requires an argument" << std::endl;
+        return false;
+      }
+      Conf.Watch.push_back(std::string(argv[i+1]));
+      i++;
+    }else if( (s=="-socket") || (s=="--socket") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --socket requires an argument" << std::endl;
+        return false;
+      }
+      Conf.Socket = std::string(argv[i+1]);
+      i++;
+    }else if( (s=="-debounce") || (s=="--debounce") ){
+      if( i+1 > (argc-1) ){
+        std::cout << "Error : --debounce requires an argument" << std::endl;
+        return false;
+      }
+      std::string P(argv[i+1]);
+      Conf.Debounce = stod(P);
+      i++;
     }else{
       // parsing error
       std::cout << "Error : unknown option : " << s << std::endl;
@@ -179,6 +355,11 @@ bool ParseArgs(int argc, char **argv, CLICONF &Conf){
     }
   }
 
+  // sweep jobs carry their own SST arguments
+  if( !Conf.Sweep.empty() ){
+    return true;
+  }
+
   if( !SetupSSTArgs(Conf) ){
     return false;
   }
@@ -187,6 +368,19 @@ bool ParseArgs(int argc, char **argv, CLICONF &Conf){
 }
 
 bool SanityCheck(CLICONF Conf){
+  if( !Conf.Sweep.empty() ){
+    // each sweep job is checked as it is loaded
+    if( Conf.JobCores == 0 ){
+      std::cout << "Error : --job-cores must be > 0" << std::endl;
+      return false;
+    }
+    if( !Conf.Socket.empty() ){
+      std::cout << "Error : --socket is not supported with --sweep" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
   if( Conf.isIter || Conf.isOneShot ){
     if( Conf.sec == 0 ){
       std::cout << "Error : Iterative or one shot configurations must specify timings of > 0 seconds" << std::endl;
@@ -196,9 +390,13 @@ bool SanityCheck(CLICONF Conf){
 
   if( (!Conf.isIter) &&
       (!Conf.isOneShot) &&
-      (!Conf.isRand) ){
+      (!Conf.isRand) &&
+      (Conf.RSS == 0) &&
+      (Conf.Stall <= 0.) &&
+      (Conf.Watch.empty()) &&
+      (Conf.Socket.empty()) ){
     std::cout << "Error : No runtime arguments found" << std::endl;
-    std::cout << "      : use --iter, --oneshot or --rand" << std::endl;
+    std::cout << "      : use --iter, --oneshot, --rand, --rss, --stall, --watch or --socket" << std::endl;
     std::cout << "      : See --help" << std::endl;
     return false;
   }
@@ -237,13 +435,115 @@ bool ChildWait(pid_t Child){
   return true;
 }
 
-bool TriggerDump(CLICONF &Conf){
-  std::cout << "<<SSTDBG>>               ------------------ DUMP ------------------              <<SSTDBG>>" << std::endl;
+bool IsTimed(CLICONF &Conf){
+  return Conf.isIter || Conf.isOneShot || Conf.isRand;
+}
+
+bool TriggerDump(CLICONF &Conf, MONITORS &Mon, const std::string &Reason = "timer"){
+  *Mon.Log << "<<SSTDBG>>               ------------------ DUMP ------------------              <<SSTDBG>>" << std::endl;
+  // snapshot the dump directory before signaling so that a fast
+  // child cannot complete its writes ahead of the baseline
+  if( Mon.Stats )
+    Mon.Stats->Trigger(Conf.pid);
+  // fork mode: every component dumping for this signal joins one snapshot
+  if( Mon.Epoch )
+    __atomic_add_fetch(Mon.Epoch, 1, __ATOMIC_RELEASE);
   kill(Conf.pid, SIGUSR2);
+  Mon.Dumps++;
+  if( Mon.Sock )
+    Mon.Sock->Broadcast("DUMP " + std::to_string(Mon.Dumps) + " " + Reason);
   return true;
 }
 
-bool ParentLoop(CLICONF &Conf){
+void SockStatus(CLICONF &Conf, MONITORS &Mon){
+  Mon.Sock->Broadcast("STATUS " + std::to_string(Conf.pid) + " " +
+                      std::to_string(Mon.Dumps) + " " +
+                      std::to_string(IsTimed(Conf) ? Conf.sec : 0) + " " +
+                      (Mon.Paused ? "paused" : "running"));
+}
+
+bool HandleSock(CLICONF &Conf, MONITORS &Mon){
+  std::vector<std::string> Cmds;
+  Mon.Sock->Poll(Cmds);
+  for( const auto& Cmd : Cmds ){
+    std::istringstream ss(Cmd);
+    std::string Op;
+    ss >> Op;
+    if( Op == "dump" ){
+      *Mon.Log << "<<SSTDBG>> Trigger : console request" << std::endl;
+      TriggerDump(Conf, Mon, "console");
+    }else if( (Op == "pause") && !Mon.Paused ){
+      kill(Conf.pid, SIGSTOP);
+      Mon.Paused = true;
+    }else if( (Op == "resume") && Mon.Paused ){
+      kill(Conf.pid, SIGCONT);
+      Mon.Paused = false;
+    }else if( Op == "interval" ){
+      unsigned Sec;
+      if( !(ss >> Sec) ){
+        Mon.Sock->Broadcast("ERR interval requires an argument");
+        continue;
+      }
+      // a zero interval leaves only requested and triggered dumps
+      Conf.isIter    = (Sec > 0);
+      Conf.isOneShot = false;
+      Conf.isRand    = false;
+      Conf.sec       = Sec;
+    }else if( Op == "status" ){
+      SockStatus(Conf, Mon);
+      continue;
+    }else if( (Op != "pause") && (Op != "resume") ){
+      Mon.Sock->Broadcast("ERR unknown command : " + Cmd);
+      continue;
+    }
+    Mon.Sock->Broadcast("OK " + Cmd);
+  }
+  return true;
+}
+
+bool Tick(CLICONF &Conf, MONITORS &Mon){
+  if( Mon.Sock )
+    HandleSock(Conf, Mon);
+
+  if( Mon.Stats ){
+    const DUMPREC *R = Mon.Stats->Poll(Conf.pid);
+    if( R && Mon.Sock )
+      Mon.Sock->Broadcast("DONE " + std::to_string(R->Id + 1) + " " +
+                          std::to_string(R->Files) + " " +
+                          std::to_string(R->Bytes) + " " +
+                          std::to_string(R->Completed - R->Sent));
+    Mon.Stats->SampleChild(Conf.pid);
+  }
+
+  std::string Reason;
+  if( Mon.Triggers && !Mon.Paused && Mon.Triggers->Poll(Conf.pid, Reason) ){
+    *Mon.Log << "<<SSTDBG>> Trigger : " << Reason << std::endl;
+    return TriggerDump(Conf, Mon, Reason);
+  }
+  return true;
+}
+
+bool WaitInterval(CLICONF &Conf, MONITORS &Mon, bool &Exited){
+  // sleep in short ticks rather than spinning so that the launcher
+  // does not steal a core from the simulation it is measuring
+  constexpr auto Tick = std::chrono::milliseconds(50);
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point end;
+  do{
+    std::this_thread::sleep_for(Tick);
+    if( !::Tick(Conf, Mon) ){
+      return false;
+    }
+    if( !IsAlive(Conf.pid, Exited) ){
+      return false;
+    }
+    end = std::chrono::steady_clock::now();
+  }while( !IsTimed(Conf) || Mon.Paused ||
+          (std::chrono::duration_cast<std::chrono::seconds>(end-begin).count() < Conf.sec) );
+  return true;
+}
+
+bool ParentLoop(CLICONF &Conf, MONITORS &Mon){
   // first check to see that our child is still alive
   bool Exited = false;
   if( !IsAlive(Conf.pid, Exited) ){
@@ -267,22 +567,26 @@ bool ParentLoop(CLICONF &Conf){
     }else if( Conf.isOneShot && (dumps == 1) ){
       // wait for the child pid to complete
       std::cout << "WAITING FOR CHILD TO END" << std :: endl;
-      if( !ChildWait(Conf.pid) ){
+      while( (Mon.Stats || Mon.Triggers || Mon.Sock) && IsAlive(Conf.pid, Exited) ){
+        // keep sampling the monitors until the child exits
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        Tick(Conf, Mon);
+      }
+      if( !Exited && !ChildWait(Conf.pid) ){
         std::cout << "<<SSTDBG>> Error : SST child process exited with an error" << std::endl;
         return false;
       }
+      return true;
     }
 
-    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-    std::chrono::steady_clock::time_point end;
-    do{
-      std::this_thread::yield();
-      end = std::chrono::steady_clock::now();
-    }while(std::chrono::duration_cast<std::chrono::seconds>(end-begin).count() < Conf.sec);
+    if( !WaitInterval(Conf, Mon, Exited) ){
+      // the child exited while we were waiting
+      break;
+    }
 
     // trigger the dump
     if( IsAlive(Conf.pid,Exited) ){
-      if( !TriggerDump(Conf) ){
+      if( !TriggerDump(Conf, Mon) ){
         // encountered an error
         // kill the child process and close everything
         kill(Conf.pid,SIGQUIT);
@@ -294,35 +598,713 @@ bool ParentLoop(CLICONF &Conf){
 
   }while(IsAlive(Conf.pid,Exited));
 
+  if( Exited )
+    std::cout << "<<SSTDBG>> Execution complete" << std::endl;
   return Exited;
 }
 
+bool Report(CLICONF &Conf, DumpStats *Stats){
+  if( !Stats )
+    return true;
+
+  Stats->PrintSummary(std::cout);
+  if( !Conf.Report.empty() ){
+    if( !Stats->Export(Conf.Report) ){
+      std::cout << "<<SSTDBG>> Error : could not write the dump report to "
+                << Conf.Report << std::endl;
+      return false;
+    }
+    std::cout << "<<SSTDBG>> Dump report written to " << Conf.Report << std::endl;
+  }
+  return true;
+}
+
+// TailCtl: lets the launcher stop a tail whose pipe outlives the SST child
+typedef struct{
+  std::atomic<bool> Stop{false};  // stop reading; set after a bounded wait
+  std::atomic<bool> Done{false};  // the tail has finished
+}TAILCTL;
+
+void TailOutput(int fd, int outfd, DumpTriggers *Triggers,
+                DebugSockServer *Sock, TAILCTL *Ctl){
+  // echo the child's stdout to outfd and match each line against the watch list;
+  // attached consoles receive each line as well
+  char Buf[4096];
+  std::string Line;
+  ssize_t n;
+  while( !Ctl->Stop ){
+    // wake periodically so that a pipe held open by a grandchild
+    // cannot keep the tail alive once the launcher gives up on it
+    struct pollfd P = {fd, POLLIN, 0};
+    int r = poll(&P, 1, 100);
+    if( r == 0 )
+      continue;
+    if( (r < 0) && (errno == EINTR) )
+      continue;
+    if( r < 0 )
+      break;
+    n = read(fd, Buf, sizeof(Buf));
+    if( n == 0 )
+      break;
+    if( n < 0 ){
+      if( errno == EINTR )
+        continue;
+      break;
+    }
+    for( ssize_t i=0; i<n; i++ ){
+      if( Buf[i] == '\n' ){
+        Triggers->OnLine(Line);
+        if( Sock )
+          Sock->Broadcast("OUT " + Line);
+        Line += '\n';
+        if( write(outfd, Line.data(), Line.size()) < 0 ){}
+        Line.clear();
+      }else{
+        Line += Buf[i];
+      }
+    }
+  }
+  if( !Line.empty() ){
+    Triggers->OnLine(Line);
+    if( Sock )
+      Sock->Broadcast("OUT " + Line);
+    Line += '\n';
+    if( write(outfd, Line.data(), Line.size()) < 0 ){}
+  }
+  close(fd);
+  Ctl->Done = true;
+}
+
+void JoinTail(std::thread &Tail, TAILCTL &Ctl){
+  // a grandchild that inherited the pipe may hold it open after SST
+  // exits; drain for a bounded time, then stop the tail
+  constexpr auto Wait = std::chrono::seconds(1);
+  if( !Tail.joinable() )
+    return;
+  auto Deadline = std::chrono::steady_clock::now() + Wait;
+  while( !Ctl.Done && (std::chrono::steady_clock::now() < Deadline) )
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  Ctl.Stop = true;
+  Tail.join();
+}
+
+bool SetupTriggers(CLICONF &Conf, DumpTriggers &Triggers){
+  if( Conf.RSS > 0 )
+    Triggers.SetRSS(Conf.RSS);
+  if( Conf.Stall > 0. )
+    Triggers.SetStall(Conf.Stall);
+  Triggers.SetDebounce(Conf.Debounce);
+  for( const auto& W : Conf.Watch ){
+    if( !Triggers.AddWatch(W) ){
+      std::cout << "Error : invalid --watch expression : " << W << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t *MapEpoch(CLICONF &Conf){
+  // fork mode: SSTDebug maps the trigger generation (SSTDBG_EPOCH) so that
+  // components on different clocks take part in the same snapshot
+  if( Conf.ForkMax == 0 )
+    return nullptr;
+  char name[] = "/tmp/sstdbg-epochXXXXXX";
+  int fd = mkstemp(name);
+  if( fd == -1 )
+    return nullptr;
+  void *P = MAP_FAILED;
+  if( ftruncate(fd, sizeof(uint64_t)) == 0 )
+    P = mmap(nullptr, sizeof(uint64_t), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if( P == MAP_FAILED ){
+    unlink(name);
+    return nullptr;
+  }
+  Conf.EpochFile = name;
+  return (uint64_t *)(P);
+}
+
+void UnmapEpoch(CLICONF &Conf, uint64_t *&Epoch){
+  if( Epoch )
+    munmap(Epoch, sizeof(uint64_t));
+  if( !Conf.EpochFile.empty() )
+    unlink(Conf.EpochFile.c_str());
+  Epoch = nullptr;
+  Conf.EpochFile.clear();
+}
+
+// ChildExec: everything an SST child needs to exec; built before the fork
+// so that the child only calls async-signal-safe functions
+typedef struct{
+  std::string Path;               // resolved executable path
+  std::vector<std::string> Env;   // child environment
+  std::vector<char *> EnvP;       // execve environment (points into Env)
+  std::string Error;              // written by the child if the exec fails
+}CHILDEXEC;
+
+std::string ResolveExec(const std::string &Name){
+  // execve does not search PATH; resolve a bare name as execvp would
+  if( Name.find('/') != std::string::npos )
+    return std::filesystem::absolute(Name).string();
+  const char *Env = getenv("PATH");
+  std::vector<std::string> Dirs;
+  SplitStr(Env ? Env : "/usr/bin:/bin", ':', Dirs);
+  for( const auto& D : Dirs ){
+    std::string P = (D.empty() ? std::string(".") : D) + "/" + Name;
+    if( access(P.c_str(), X_OK) == 0 )
+      return std::filesystem::absolute(P).string();
+  }
+  return Name;
+}
+
+void SetupChildExec(CLICONF &Conf, CHILDEXEC &Exec){
+  Exec.Path = ResolveExec(Conf.SSTPath);
+
+  // SSTDebug reads the snapshot child limit and the trigger counter at startup
+  std::vector<std::string> Set;
+  if( Conf.ForkMax > 0 )
+    Set.push_back("SSTDBG_FORK=" + std::to_string(Conf.ForkMax));
+  if( !Conf.EpochFile.empty() )
+    Set.push_back("SSTDBG_EPOCH=" + Conf.EpochFile);
+  for( char **E = environ; *E != nullptr; E++ ){
+    std::string V(*E);
+    bool Replaced = false;
+    for( const auto& S : Set )
+      Replaced |= (V.compare(0, S.find('=')+1, S, 0, S.find('=')+1) == 0);
+    if( !Replaced )
+      Exec.Env.push_back(V);
+  }
+  Exec.Env.insert(Exec.Env.end(), Set.begin(), Set.end());
+  for( auto& V : Exec.Env )
+    Exec.EnvP.push_back(&V[0]);
+  Exec.EnvP.push_back(nullptr);
+
+  Exec.Error = "Error : Encountered an error with SST : cannot execute " + Exec.Path + "\n";
+}
+
 bool ExecuteSST(CLICONF &Conf, char **argv){
 
+  DumpTriggers Triggers;
+  if( !SetupTriggers(Conf, Triggers) ){
+    return false;
+  }
+
+  DebugSockServer Sock;
+  if( !Conf.Socket.empty() && !Sock.Listen(Conf.Socket) ){
+    std::cout << "Error : Cannot listen on socket " << Conf.Socket << " : "
+              << strerror(errno) << std::endl;
+    return false;
+  }
+
+  // only tail the child's output when a watch expression or an
+  // attached console requires it
+  int Pipe[2] = {-1, -1};
+  if( (Triggers.Watching() || !Conf.Socket.empty()) && (pipe(Pipe) == -1) ){
+    std::cout << "Error : Cannot create pipe for SST child process" << std::endl;
+    return false;
+  }
+
+  uint64_t *Epoch = MapEpoch(Conf);
+
+  CHILDEXEC Exec;
+  SetupChildExec(Conf, Exec);
+  std::cout << "<<SSTDBG>> Executing SST" << std::endl;
+  std::cout << "<<SSTDBG>> " << Conf.SSTPath << " " << Conf.SSTArgs << std::endl;
+
   Conf.pid = fork();
 
   if( Conf.pid == -1 ){
     // error occurred
     std::cout << "Error : Cannot fork child SST process" << std::endl;
+    UnmapEpoch(Conf, Epoch);
     return false;
   }else if( Conf.pid == 0 ){
     // child process
-    std::cout << "<<SSTDBG>> Executing SST" << std::endl;
-    std::cout << "<<SSTDBG>> " << Conf.SSTPath << " " << Conf.SSTArgs << std::endl;
+    if( Pipe[1] != -1 ){
+      while( (dup2(Pipe[1], STDOUT_FILENO) == -1) && (errno == EINTR) ) {}
+      close(Pipe[0]);
+      close(Pipe[1]);
+    }
+
+    execve(Exec.Path.c_str(), &argv[Conf.ArgC], Exec.EnvP.data());
+    if( write(STDERR_FILENO, Exec.Error.data(), Exec.Error.size()) < 0 ){}
+    _exit(127);
+  }else{
+    // main event loop
+    std::thread Tail;
+    TAILCTL TailCtl;
+    if( Pipe[0] != -1 ){
+      close(Pipe[1]);
+      Tail = std::thread(TailOutput, Pipe[0], STDOUT_FILENO, &Triggers,
+                         Conf.Socket.empty() ? nullptr : &Sock, &TailCtl);
+    }
+
+    // attached consoles are told when each dump completes
+    std::unique_ptr<DumpStats> Stats;
+    if( Conf.isStats || !Conf.Socket.empty() )
+      Stats.reset(new DumpStats(Conf.DumpDir));
 
-    if( execvp(Conf.SSTPath.c_str(),
-               &argv[Conf.ArgC]) == -1 ){
-      std::cout << "Error : Encountered an error with SST : " << strerror(errno) << std::endl;
+    MONITORS Mon;
+    Mon.Stats    = Stats.get();
+    Mon.Triggers = Triggers.Enabled() ? &Triggers : nullptr;
+    Mon.Log      = &std::cout;
+    Mon.Dumps    = 0;
+    Mon.Sock     = Conf.Socket.empty() ? nullptr : &Sock;
+    Mon.Paused   = false;
+    Mon.Epoch    = Epoch;
+    Sock.SetHello("HELLO " + std::to_string(Conf.pid) + " " +
+                  std::to_string(IsTimed(Conf) ? Conf.sec : 0));
+
+    DumpRetention Retain(Conf.DumpDir, Conf.Keep, (uint64_t)(Conf.KeepMB) << 20);
+    Retain.Start();
+
+    bool rtn = ParentLoop(Conf, Mon);
+    UnmapEpoch(Conf, Mon.Epoch);
+    JoinTail(Tail, TailCtl);
+    if( Mon.Sock ){
+      Sock.Broadcast(std::string("EXIT ") + (rtn ? "0" : "1"));
+      Sock.Close();
+    }
+
+    if( Retain.Enabled() ){
+      Retain.Stop();
+      std::cout << "<<SSTDBG>> Retention removed " << Retain.Removed()
+                << " dump files (" << Retain.Reclaimed() << " bytes)" << std::endl;
+    }
+    if( !Report(Conf, Conf.isStats ? Stats.get() : nullptr) )
       return false;
+    return rtn;
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------
+// SWEEP MODE
+//---------------------------------------------------------------
+typedef enum{
+  JOB_QUEUED,   // waiting for cores
+  JOB_RUNNING,  // executing
+  JOB_DONE,     // exited successfully
+  JOB_FAILED    // exited with an error
+}JOBSTATE;
+
+typedef struct{
+  unsigned Id;                  // job number (line order)
+  JOBSTATE State;               // job state
+  int Status;                   // exit status
+  std::string Line;             // sweep file line
+  std::string Dir;              // isolated output directory
+  std::vector<std::string> Args;// sst-dbg style argument vector
+  std::vector<char *> ArgV;     // exec argument vector (points into Args)
+  std::vector<int> Cores;       // pinned cores
+  CLICONF Conf;                 // job configuration
+  MONITORS Mon;                 // job monitors
+  bool Timed;                   // timed dumps remain
+  std::chrono::steady_clock::time_point Start;
+  std::chrono::steady_clock::time_point End;
+  std::chrono::steady_clock::time_point NextDump;
+  std::unique_ptr<std::ofstream> Log;
+  std::unique_ptr<DumpTriggers> Triggers;
+  std::unique_ptr<DumpStats> Stats;
+  std::unique_ptr<DumpRetention> Retain;
+  std::thread Tail;
+  TAILCTL TailCtl;
+  int LogFd;                    // sst.log descriptor written by Tail
+}SWEEPJOB;
+
+void TokenizeLine(const std::string& Line, std::vector<std::string>& v){
+  // whitespace separated tokens; single and double quotes group
+  std::string Tok;
+  bool InTok = false;
+  char Quote = 0;
+  for( char c : Line ){
+    if( Quote ){
+      if( c == Quote )
+        Quote = 0;
+      else
+        Tok += c;
+    }else if( (c == '"') || (c == '\'') ){
+      Quote = c;
+      InTok = true;
+    }else if( isspace((unsigned char)c) ){
+      if( InTok )
+        v.push_back(Tok);
+      Tok.clear();
+      InTok = false;
+    }else{
+      Tok += c;
+      InTok = true;
+    }
+  }
+  if( InTok )
+    v.push_back(Tok);
+}
+
+std::vector<int> AvailableCores(unsigned Budget){
+  // honor the launcher's own affinity mask (e.g. a batch allocation)
+  std::vector<int> Cores;
+  cpu_set_t Set;
+  CPU_ZERO(&Set);
+  if( sched_getaffinity(0, sizeof(Set), &Set) == 0 ){
+    for( int i=0; i<CPU_SETSIZE; i++ ){
+      if( CPU_ISSET(i, &Set) )
+        Cores.push_back(i);
+    }
+  }
+  if( Cores.empty() ){
+    for( unsigned i=0; i<std::thread::hardware_concurrency(); i++ )
+      Cores.push_back(i);
+  }
+  if( (Budget > 0) && (Budget < Cores.size()) )
+    Cores.resize(Budget);
+  return Cores;
+}
+
+void InheritSchedule(const CLICONF &Global, CLICONF &Job){
+  // snapshot, retention and overhead options apply to every job unless
+  // the job sets its own
+  if( Job.ForkMax == 0 )
+    Job.ForkMax = Global.ForkMax;
+  if( !Job.isStats )
+    Job.isStats = Global.isStats;
+  if( Job.Keep == 0 )
+    Job.Keep = Global.Keep;
+  if( Job.KeepMB == 0 )
+    Job.KeepMB = Global.KeepMB;
+
+  // jobs without their own dump triggers use the global schedule
+  if( IsTimed(Job) || (Job.RSS > 0) || (Job.Stall > 0.) || !Job.Watch.empty() )
+    return;
+  Job.isIter    = Global.isIter;
+  Job.isOneShot = Global.isOneShot;
+  Job.isRand    = Global.isRand;
+  Job.sec       = Global.sec;
+  Job.RSS       = Global.RSS;
+  Job.Stall     = Global.Stall;
+  Job.Debounce  = Global.Debounce;
+  Job.Watch     = Global.Watch;
+}
+
+bool LoadSweep(CLICONF &Conf, std::vector<std::unique_ptr<SWEEPJOB>>& Jobs){
+  std::ifstream Input(Conf.Sweep);
+  if( !Input.is_open() ){
+    std::cout << "Error : cannot open sweep file " << Conf.Sweep << std::endl;
+    return false;
+  }
+
+  std::string Line;
+  unsigned LineNo = 0;
+  while( std::getline(Input,Line) ){
+    LineNo++;
+    auto first = Line.find_first_not_of(" \t");
+    if( (first == std::string::npos) || (Line[first] == '#') )
+      continue;
+
+    std::unique_ptr<SWEEPJOB> Job(new SWEEPJOB());
+    Job->Id     = (unsigned)(Jobs.size());
+    Job->State  = JOB_QUEUED;
+    Job->Status = 0;
+    Job->Line   = Line;
+    Job->Timed  = false;
+    Job->LogFd  = -1;
+    Job->Dir    = (std::filesystem::path(Conf.DumpDir) /
+                   ("job." + std::to_string(Job->Id))).string();
+
+    std::vector<std::string> Tokens;
+    TokenizeLine(Line, Tokens);
+    if( std::find(Tokens.begin(), Tokens.end(), "--") == Tokens.end() )
+      Tokens.insert(Tokens.begin(), "--");
+
+    // jobs run in their own directory; anchor relative input files
+    auto Sep = std::find(Tokens.begin(), Tokens.end(), "--");
+    for( auto it = Sep+1; it != Tokens.end(); ++it ){
+      if( (it == Sep+1) || it->empty() || ((*it)[0] == '-') )
+        continue;
+      std::error_code ec;
+      if( std::filesystem::path(*it).is_relative() &&
+          std::filesystem::exists(*it, ec) )
+        *it = std::filesystem::absolute(*it).string();
     }
+
+    Job->Args.push_back("sst-dbg");
+    Job->Args.insert(Job->Args.end(), Tokens.begin(), Tokens.end());
+    for( auto& A : Job->Args )
+      Job->ArgV.push_back(&A[0]);
+    Job->ArgV.push_back(nullptr);
+
+    if( !ParseArgs((int)(Job->Args.size()), Job->ArgV.data(), Job->Conf) ||
+        Job->Conf.isHelp ){
+      std::cout << "Error : invalid sweep job at " << Conf.Sweep << ":" << LineNo << std::endl;
+      return false;
+    }
+    // sweep jobs are not attached to a live socket
+    if( !Job->Conf.Socket.empty() ){
+      std::cout << "Error : --socket is not supported in sweep jobs at "
+                << Conf.Sweep << ":" << LineNo << std::endl;
+      return false;
+    }
+    InheritSchedule(Conf, Job->Conf);
+    Job->Conf.DumpDir = Job->Dir;
+    if( !SanityCheck(Job->Conf) ){
+      std::cout << "Error : invalid sweep job at " << Conf.Sweep << ":" << LineNo << std::endl;
+      return false;
+    }
+
+    Jobs.push_back(std::move(Job));
+  }
+
+  if( Jobs.empty() ){
+    std::cout << "Error : no jobs found in " << Conf.Sweep << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool StartJob(SWEEPJOB &Job, std::vector<int>& FreeCores, unsigned JobCores){
+  std::error_code ec;
+  std::filesystem::create_directories(Job.Dir, ec);
+  std::string LogName = (std::filesystem::path(Job.Dir) / "sst.log").string();
+  int LogFd = open(LogName.c_str(), O_WRONLY|O_CREAT|O_APPEND, 0644);
+  if( LogFd == -1 ){
+    std::cout << "<<SSTDBG>> Error : cannot create " << LogName << std::endl;
+    return false;
+  }
+
+  Job.Triggers.reset(new DumpTriggers());
+  if( !SetupTriggers(Job.Conf, *Job.Triggers) ){
+    close(LogFd);
+    return false;
+  }
+
+  int Pipe[2] = {-1, -1};
+  if( Job.Triggers->Watching() && (pipe(Pipe) == -1) ){
+    close(LogFd);
+    return false;
+  }
+
+  Job.Cores.assign(FreeCores.begin(), FreeCores.begin()+JobCores);
+  FreeCores.erase(FreeCores.begin(), FreeCores.begin()+JobCores);
+  Job.Mon.Epoch = MapEpoch(Job.Conf);
+  CHILDEXEC Exec;
+  SetupChildExec(Job.Conf, Exec);
+
+  Job.Conf.pid = fork();
+  if( Job.Conf.pid == -1 ){
+    FreeCores.insert(FreeCores.end(), Job.Cores.begin(), Job.Cores.end());
+    Job.Cores.clear();
+    UnmapEpoch(Job.Conf, Job.Mon.Epoch);
+    close(LogFd);
+    return false;
+  }else if( Job.Conf.pid == 0 ){
+    // child process: pin, isolate and execute
+    cpu_set_t Set;
+    CPU_ZERO(&Set);
+    for( int c : Job.Cores )
+      CPU_SET(c, &Set);
+    sched_setaffinity(0, sizeof(Set), &Set);
+
+    if( chdir(Job.Dir.c_str()) == -1 )
+      _exit(127);
+
+    int OutFd = (Pipe[1] != -1) ? Pipe[1] : LogFd;
+    while( (dup2(OutFd, STDOUT_FILENO) == -1) && (errno == EINTR) ) {}
+    while( (dup2(LogFd, STDERR_FILENO) == -1) && (errno == EINTR) ) {}
+    if( Pipe[0] != -1 ){
+      close(Pipe[0]);
+      close(Pipe[1]);
+    }
+    close(LogFd);
+
+    execve(Exec.Path.c_str(), &Job.ArgV[Job.Conf.ArgC], Exec.EnvP.data());
+    if( write(STDERR_FILENO, Exec.Error.data(), Exec.Error.size()) < 0 ){}
+    _exit(127);
+  }
+
+  // parent process
+  Job.State = JOB_RUNNING;
+  Job.Start = std::chrono::steady_clock::now();
+  Job.NextDump = Job.Start + std::chrono::seconds(Job.Conf.sec);
+  Job.Timed = IsTimed(Job.Conf);
+
+  if( Pipe[0] != -1 ){
+    close(Pipe[1]);
+    Job.Tail = std::thread(TailOutput, Pipe[0], LogFd, Job.Triggers.get(), nullptr,
+                           &Job.TailCtl);
+    Job.LogFd = LogFd;
   }else{
-    // main event loop
-    return ParentLoop(Conf);
+    close(LogFd);
   }
 
+  Job.Log.reset(new std::ofstream(LogName, std::ios::out|std::ios::app));
+  if( Job.Conf.isStats )
+    Job.Stats.reset(new DumpStats(Job.Dir));
+  Job.Retain.reset(new DumpRetention(Job.Dir, Job.Conf.Keep,
+                                     (uint64_t)(Job.Conf.KeepMB) << 20));
+  Job.Retain->Start();
+
+  Job.Mon.Stats    = Job.Stats.get();
+  Job.Mon.Triggers = Job.Triggers->Enabled() ? Job.Triggers.get() : nullptr;
+  Job.Mon.Log      = Job.Log.get();
+  Job.Mon.Dumps    = 0;
+  Job.Mon.Sock     = nullptr;
+  Job.Mon.Paused   = false;
   return true;
 }
 
+void FinishJob(SWEEPJOB &Job, int Status, std::vector<int>& FreeCores){
+  Job.End    = std::chrono::steady_clock::now();
+  Job.Status = Status;
+  Job.State  = (WIFEXITED(Status) && (WEXITSTATUS(Status) == 0)) ? JOB_DONE : JOB_FAILED;
+
+  UnmapEpoch(Job.Conf, Job.Mon.Epoch);
+  JoinTail(Job.Tail, Job.TailCtl);
+  if( Job.LogFd != -1 ){
+    close(Job.LogFd);
+    Job.LogFd = -1;
+  }
+  Job.Retain->Stop();
+  if( Job.Stats ){
+    Job.Stats->PrintSummary(*Job.Log);
+    if( !Job.Conf.Report.empty() )
+      Job.Stats->Export(Job.Conf.Report);
+  }
+  Job.Log->close();
+
+  FreeCores.insert(FreeCores.end(), Job.Cores.begin(), Job.Cores.end());
+}
+
+void PollJob(SWEEPJOB &Job, std::vector<int>& FreeCores){
+  int Status = 0;
+  pid_t result = waitpid(Job.Conf.pid, &Status, WNOHANG);
+  if( result == -1 ){
+    FinishJob(Job, -1, FreeCores);
+    return;
+  }else if( result != 0 ){
+    FinishJob(Job, Status, FreeCores);
+    return;
+  }
+
+  Tick(Job.Conf, Job.Mon);
+
+  if( Job.Timed && (std::chrono::steady_clock::now() >= Job.NextDump) ){
+    TriggerDump(Job.Conf, Job.Mon);
+    if( Job.Conf.isOneShot )
+      Job.Timed = false;
+    Job.NextDump += std::chrono::seconds(Job.Conf.sec);
+  }
+}
+
+std::string CoreStr(const std::vector<int>& Cores){
+  std::string S;
+  for( unsigned i=0; i<Cores.size(); i++ ){
+    if( i > 0 )
+      S += ",";
+    S += std::to_string(Cores[i]);
+  }
+  return S;
+}
+
+void PrintSweepStatus(std::vector<std::unique_ptr<SWEEPJOB>>& Jobs,
+                      unsigned Budget, unsigned Free, double Elapsed){
+  unsigned Counts[4] = {0, 0, 0, 0};
+  for( auto& J : Jobs )
+    Counts[J->State]++;
+
+  std::cout << "<<SSTDBG>> [" << std::fixed << std::setprecision(1) << Elapsed << "s]"
+            << " queued=" << Counts[JOB_QUEUED]
+            << " running=" << Counts[JOB_RUNNING]
+            << " done=" << Counts[JOB_DONE]
+            << " failed=" << Counts[JOB_FAILED]
+            << " cores=" << (Budget-Free) << "/" << Budget << std::endl;
+  for( auto& J : Jobs ){
+    if( J->State != JOB_RUNNING )
+      continue;
+    double T = std::chrono::duration<double>(std::chrono::steady_clock::now() - J->Start).count();
+    std::cout << "<<SSTDBG>>   job." << J->Id
+              << " pid=" << J->Conf.pid
+              << " cores=" << CoreStr(J->Cores)
+              << " time=" << T << "s"
+              << " dumps=" << J->Mon.Dumps << std::endl;
+  }
+  std::cout << std::defaultfloat;
+}
+
+bool RunSweep(CLICONF &Conf){
+  std::vector<std::unique_ptr<SWEEPJOB>> Jobs;
+  if( !LoadSweep(Conf, Jobs) ){
+    return false;
+  }
+
+  std::vector<int> FreeCores = AvailableCores(Conf.Cores);
+  const unsigned Budget = (unsigned)(FreeCores.size());
+  if( Conf.JobCores > Budget ){
+    std::cout << "Error : --job-cores " << Conf.JobCores
+              << " exceeds the core budget of " << Budget << std::endl;
+    return false;
+  }
+
+  std::cout << "<<SSTDBG>> Sweep : " << Jobs.size() << " jobs on "
+            << Budget << " cores (" << Conf.JobCores << " per job)" << std::endl;
+
+  auto Begin = std::chrono::steady_clock::now();
+  auto NextStatus = Begin;
+  unsigned Next = 0;
+  unsigned Running = 0;
+
+  while( (Next < Jobs.size()) || (Running > 0) ){
+    // launch queued jobs while the budget allows
+    while( (Next < Jobs.size()) && (FreeCores.size() >= Conf.JobCores) ){
+      SWEEPJOB &Job = *Jobs[Next++];
+      if( StartJob(Job, FreeCores, Conf.JobCores) ){
+        Running++;
+      }else{
+        Job.State = JOB_FAILED;
+        Job.Status = -1;
+        std::cout << "<<SSTDBG>> Error : could not start job." << Job.Id << std::endl;
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for( auto& J : Jobs ){
+      if( J->State != JOB_RUNNING )
+        continue;
+      PollJob(*J, FreeCores);
+      if( J->State != JOB_RUNNING ){
+        Running--;
+        std::cout << "<<SSTDBG>> job." << J->Id
+                  << (J->State == JOB_DONE ? " complete" : " FAILED")
+                  << " : " << J->Line << std::endl;
+      }
+    }
+
+    auto Now = std::chrono::steady_clock::now();
+    if( (Conf.StatusSec > 0) && (Now >= NextStatus) ){
+      PrintSweepStatus(Jobs, Budget, (unsigned)(FreeCores.size()),
+                       std::chrono::duration<double>(Now - Begin).count());
+      NextStatus = Now + std::chrono::seconds(Conf.StatusSec);
+    }
+  }
+
+  // final summary
+  bool rtn = true;
+  std::cout << "<<SSTDBG>> Sweep complete" << std::endl;
+  for( auto& J : Jobs ){
+    double T = std::chrono::duration<double>(J->End - J->Start).count();
+    std::cout << "<<SSTDBG>>   job." << J->Id
+              << (J->State == JOB_DONE ? " PASS" : " FAIL")
+              << " time=" << std::fixed << std::setprecision(1) << T << "s"
+              << std::defaultfloat
+              << " dumps=" << J->Mon.Dumps
+              << " dir=" << J->Dir
+              << " : " << J->Line << std::endl;
+    if( J->State != JOB_DONE )
+      rtn = false;
+  }
+  return rtn;
+}
+
 int main(int argc, char **argv){
 
   CLICONF Conf;
@@ -348,7 +1330,11 @@ int main(int argc, char **argv){
   }
 
   // Execute
-  if( !ExecuteSST(Conf,argv) ){
+  if( !Conf.Sweep.empty() ){
+    if( !RunSweep(Conf) ){
+      return -1;
+    }
+  }else if( !ExecuteSST(Conf,argv) ){
     return -1;
   }
 
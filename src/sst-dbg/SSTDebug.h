@@ -14,6 +14,7 @@
 // -- CXX Headers
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <typeinfo>
 #include <string>
 #include <vector>
@@ -22,11 +23,36 @@
 #include <typeinfo>
 #include <dirent.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include <fnmatch.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #ifdef SSTDBG_MPI
 #include <mpi.h>
 #endif
 
+#ifdef SSTDBG_SHM
+#include "SSTDebugRing.h"
+#endif
+
 // -- Required Macros
 #define SSTCYCLE  uint64_t
 #define SSTVALUE  std::vector<std::pair<std::string,std::string>>
@@ -34,191 +60,1455 @@
 #define VARNAME(v) #v
 #define DARG(v) VARNAME(v), v
 
+/// SSTDebugIsSeq: arrays and STL containers other than strings
+template<typename T, typename = void>
+struct SSTDebugIsSeq : std::false_type {};
+
+template<typename T>
+struct SSTDebugIsSeq<T, decltype(void(std::begin(std::declval<const T&>())),
+                                 void(std::end(std::declval<const T&>())))>
+  : std::integral_constant<bool,
+      !std::is_same<typename std::decay<decltype(*std::begin(std::declval<const T&>()))>::type,
+                    char>::value> {};
+
+/// SSTDebugIsPair: std::pair, including the elements of associative containers
+template<typename T>
+struct SSTDebugIsPair : std::false_type {};
+
+template<typename T1, typename T2>
+struct SSTDebugIsPair<std::pair<T1,T2>> : std::true_type {};
+
+/// SSTDebugCounters: self-instrumentation counters of the dump path
+struct SSTDebugCounters {
+  uint64_t Dumps    = 0;    ///< Records handed to the sinks
+  uint64_t Fields   = 0;    ///< Values written
+  uint64_t Bytes    = 0;    ///< Bytes written
+  uint64_t FormatNs = 0;    ///< Nanoseconds spent formatting records
+  uint64_t IoNs     = 0;    ///< Nanoseconds spent writing records
+
+  SSTDebugCounters& operator+=(const SSTDebugCounters& C){
+    Dumps    += C.Dumps;
+    Fields   += C.Fields;
+    Bytes    += C.Bytes;
+    FormatNs += C.FormatNs;
+    IoNs     += C.IoNs;
+    return *this;
+  }
+};
+
 class SSTDebug {
 private:
 
   // Private variables
   std::string Name;       ///< Name of the component
   std::string Path;       ///< Output path
-  std::ofstream Bin;      ///< Output stream
+  std::function<void(SSTCYCLE)> Snapshot; ///< Snapshot callback (fork mode)
+
+  /// SSTDebug: a registered watch variable and its precomputed layout
+  typedef struct WATCH{
+    const void *Ptr;                ///< Watched storage
+    size_t Count;                   ///< Number of elements
+    size_t Bytes;                   ///< Staged bytes; 0 if formatted in place
+    size_t Offset;                  ///< Offset in the staging buffer
+    std::string Key;                ///< Preformatted key
+    void (*Format)(std::ostream&, const void*, const struct WATCH&);
+  }WATCH;
+
+  std::vector<WATCH> Watches;       ///< Registered watch variables
+  std::vector<uint8_t> Stage;       ///< Staging buffer for watched POD data
+  bool SnapshotMode = false;        ///< Is this object dumped with snapshot()?
+  uint64_t DumpEpoch = 0;           ///< Last fork mode dump epoch taken part in
+
+  // Nested scopes
+  SSTDebug *Parent = nullptr;       ///< Enclosing scope; nullptr for a record root
+  std::string ScopePath;            ///< Key path below the root (e.g., "msg/")
+  std::vector<std::unique_ptr<SSTDebug>> Scopes;  ///< Child scopes
+  std::string Pending;              ///< Values awaiting the root's next record
+  SSTCYCLE PendingCycle = 0;        ///< Cycle of the pending values
+  bool HasPending = false;          ///< Are values pending?
+  bool Watched = false;             ///< Do the pending values include the watches?
+
+  // Sampling policy resolved at construction
+  bool Sampled = false;             ///< Is any sampling rule active?
+  unsigned Every = 0;               ///< Write every Nth dump call; 0 writes all
+  unsigned Calls = 0;               ///< Dump calls seen by the Every rule
+  SSTCYCLE Mod = 0;                 ///< Write only cycles divisible by Mod; 0 writes all
+  uint64_t ProbCut = (1ull << 32);  ///< Write when the next random draw is below this
+  uint64_t Rng = 0;                 ///< xorshift state for the probability rule
+
+  // Self-instrumentation; the counters of a scope are charged to its root
+  SSTDebugCounters Counters;        ///< Cost of this object's records
+
+  // Key filter
+  bool Filtered = false;            ///< Is a key filter active?
+  std::unordered_map<std::string, bool> KeyCache;   ///< Filter decision per key name
+
+  /// SSTDebug: the compiled key filter; index 0 holds the includes and
+  /// index 1 the excludes
+  typedef struct{
+    std::unordered_set<std::string> Exact[2];   ///< Literal component.key names
+    std::vector<std::string> Globs[2];          ///< component.key glob patterns
+  }FILTER;
+
+  /// SSTDebug: a sampling rule for the components matching a name pattern
+  typedef struct{
+    std::string Pattern;            ///< Component name glob (fnmatch)
+    unsigned Every;                 ///< Write every Nth dump call
+    SSTCYCLE Mod;                   ///< Write only cycles divisible by Mod
+    double Prob;                    ///< Probability that a dump is written
+  }SAMPLE;
+
+  /// SSTDebug: process-wide state for copy-on-write snapshot dumps
+  ///
+  /// A dump epoch is one dump request.  When the launcher shares its
+  /// trigger counter (SSTDBG_EPOCH), the epoch is the trigger generation;
+  /// otherwise an epoch ends when an object that already dumped in it dumps
+  /// again.  The first kept dump of an epoch forks a child.  Every snapshot
+  /// capable object then sends its own cycle down the epoch's pipe as it
+  /// dumps, and the child writes that object's copy-on-write state under it,
+  /// so components on different clocks keep their own cycles.
+  struct ForkState {
+    std::mutex Lock;                    ///< Guards the registry and the epoch
+    std::vector<SSTDebug *> Registry;   ///< Live SSTDebug objects
+    std::deque<pid_t> Children;         ///< Outstanding snapshot children
+    unsigned MaxChildren = 0;           ///< Max concurrent children; 0 disables fork mode
+    bool InSnapshot = false;            ///< Are we the snapshot child?
+    const uint64_t *Trigger = nullptr;  ///< Launcher's trigger counter; nullptr if none
+    uint64_t Gen = 0;                   ///< Trigger generation of the current epoch
+    uint64_t Epoch = 0;                 ///< Current dump epoch; 0 before the first
+    size_t Seen = 0;                    ///< Objects that dumped in the current epoch
+    size_t Expected = 0;                ///< Snapshot capable objects at its start
+    bool Forked = false;                ///< Has the current epoch forked its child?
+    int Pipe = -1;                      ///< Write end of the child's cycle pipe
+
+    ForkState(){
+      // SSTDBG_FORK=N enables fork mode with at most N snapshot children
+      const char *Env = std::getenv("SSTDBG_FORK");
+      if( Env != nullptr )
+        MaxChildren = (unsigned)(std::strtoul(Env, nullptr, 10));
+
+      // SSTDBG_EPOCH names the launcher's mapped trigger counter
+      const char *File = std::getenv("SSTDBG_EPOCH");
+      if( (File == nullptr) || (*File == '\0') )
+        return;
+      int fd = open(File, O_RDONLY);
+      if( fd == -1 )
+        return;
+      void *P = mmap(nullptr, sizeof(uint64_t), PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if( P != MAP_FAILED )
+        Trigger = (const uint64_t *)(P);
+    }
+  };
 
-  template<typename T, typename U, typename... Args>
-  void __internal_dump(T t, U u, Args... args){
-    __internal_dump(t,u);
-    __internal_dump(args...);
+  /// SSTDebug: a cycle sent to the snapshot child of an epoch
+  typedef struct{
+    SSTDebug *Obj;                  ///< Object to write
+    SSTCYCLE Cycle;                 ///< Its cycle at this dump
+  }SNAPMSG;
+
+  static ForkState& Fork(){
+    static ForkState State;
+    return State;
   }
 
-  template<typename... Args>
-  void __internal_dump(Args... args){
+  /// SSTDebug: reaps finished snapshot children; blocks while the limit is reached
+  /// The caller holds the fork state lock
+  static void ReapSnapshots(unsigned Limit){
+    ForkState &F = Fork();
+    for( auto it = F.Children.begin(); it != F.Children.end(); ){
+      int status = 0;
+      if( waitpid(*it, &status, WNOHANG) != 0 )
+        it = F.Children.erase(it);
+      else
+        ++it;
+    }
+    while( !F.Children.empty() && (F.Children.size() >= Limit) ){
+      int status = 0;
+      waitpid(F.Children.front(), &status, 0);
+      F.Children.pop_front();
+    }
   }
 
-  template<typename T1, typename T2>
-  void __internal_dump(T1 v1, T2 v2){
+  /// SSTDebug: closes the cycle pipe of the current epoch; its child
+  /// writes the cycles it was sent and exits
+  /// The caller holds the fork state lock
+  static void EndEpoch(){
+    ForkState &F = Fork();
+    if( F.Pipe != -1 ){
+      close(F.Pipe);
+      F.Pipe = -1;
+    }
+  }
+
+  /// SSTDebug: forks the snapshot child of the current epoch
+  /// The caller holds the fork state lock
+  static void ForkEpoch(){
+    ForkState &F = Fork();
+    F.Forked = true;
+
 #ifdef SSTDBG_MPI
+    // resolve the rank before forking; the child must not call into MPI
+    Rank();
+#endif
+#ifdef SSTDBG_SHM
+    Shm();
+#endif
+    // only the forking thread runs in the child, and a lock held by any
+    // other thread at fork() is never released there: the child must not
+    // take process-wide locks.  The lazily created state of this thread is
+    // set up now so the child's dumps find it in place.
+    __buffer();
+    Shard();
+    Thread();
+
+    ReapSnapshots(F.MaxChildren);
+
+    int fd[2];
+    if( pipe(fd) == -1 )
+      return;
+    pid_t pid = fork();
+    if( pid == -1 ){
+      // the epoch falls back to synchronous dumps
+      close(fd[0]);
+      close(fd[1]);
+      return;
+    }else if( pid == 0 ){
+      // snapshot child: write the copy-on-write state of each object under
+      // the cycle it sent, then exit without running any of the parent's
+      // exit handlers.  Objects created after the fork are not in the copy.
+      F.InSnapshot = true;
+      close(fd[1]);
+      std::unordered_set<SSTDebug *> Live(F.Registry.begin(), F.Registry.end());
+      SNAPMSG M;
+      ssize_t n;
+      while( ((n = read(fd[0], &M, sizeof(M))) == (ssize_t)(sizeof(M))) ||
+             ((n == -1) && (errno == EINTR)) ){
+        if( (n == -1) || (Live.count(M.Obj) == 0) )
+          continue;
+        if( M.Obj->Snapshot )
+          M.Obj->Snapshot(M.Cycle);
+        else if( M.Obj->SnapshotMode )
+          M.Obj->snapshot(M.Cycle);
+      }
+      _exit(0);
+    }
+
+    // the parent never blocks on a slow child: a full pipe falls back to a
+    // synchronous dump, and SST's own children do not inherit the pipe
+    close(fd[0]);
+    fcntl(fd[1], F_SETFL, O_NONBLOCK);
+    fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+    F.Pipe = fd[1];
+    F.Children.push_back(pid);
+  }
+
+  /// SSTDebug: takes part in the current dump epoch with D's own cycle
+  /// Keep is D's sampling decision for this dump.  Returns true if the dump
+  /// is handled (captured by the snapshot child or sampled out) and false
+  /// if D must write it synchronously.
+  static bool ForkSnapshot(SSTDebug *D, SSTCYCLE cycle, bool Keep){
+    ForkState &F = Fork();
+    std::lock_guard<std::mutex> lock(F.Lock);
+    const bool Repeat = (F.Epoch != 0) && (D->DumpEpoch == F.Epoch);
+    bool Next = (F.Epoch == 0) || Repeat;
+    if( F.Trigger != nullptr ){
+      const uint64_t Gen = __atomic_load_n(F.Trigger, __ATOMIC_ACQUIRE);
+      // a second dump within one trigger is not part of the snapshot
+      if( Repeat && (Gen == F.Gen) )
+        return !Keep;
+      Next = (F.Epoch == 0) || (Gen != F.Gen);
+      F.Gen = Gen;
+    }
+
+    if( Next ){
+      EndEpoch();
+      F.Epoch++;
+      F.Seen     = 0;
+      F.Expected = 0;
+      F.Forked   = false;
+      for( auto *R : F.Registry )
+        if( R->Snapshot || R->SnapshotMode )
+          F.Expected++;
+    }
+    D->DumpEpoch = F.Epoch;
+    F.Seen++;
+
+    bool rtn = true;
+    if( Keep ){
+      if( !F.Forked )
+        ForkEpoch();
+      SNAPMSG M = {D, cycle};
+      rtn = (F.Pipe != -1) && (write(F.Pipe, &M, sizeof(M)) == (ssize_t)(sizeof(M)));
+    }
+
+    // every object has taken part; let the child finish
+    if( F.Seen >= F.Expected )
+      EndEpoch();
+    return rtn;
+  }
+
+#ifdef SSTDBG_MPI
+  /// SSTDebug: returns the cached MPI rank; -1 if MPI is not initialized
+  static int Rank(){
+    static std::atomic<int> CachedRank{-1};
+    if( CachedRank.load(std::memory_order_relaxed) == -1 ){
+      int isInit = 0;
+      MPI_Initialized(&isInit);
+      if( isInit ){
+        int R = -1;
+        MPI_Comm_rank(MPI_COMM_WORLD, &R);
+        CachedRank.store(R, std::memory_order_relaxed);
+      }
+    }
+    return CachedRank.load(std::memory_order_relaxed);
+  }
+#endif
+
+  /// SSTDebug: returns the calling thread's shard index; each simulation
+  /// thread writes its own shard of the per-rank dump files
+  static unsigned Shard(){
+    static std::atomic<unsigned> Next{0};
+    thread_local unsigned Id = Next.fetch_add(1, std::memory_order_relaxed);
+    return Id;
+  }
+
+  /// SSTDebug: returns the calling thread's record buffer; reused so that
+  /// formatting a record does not reallocate on every dump
+  static std::ostringstream& __buffer(){
+    thread_local std::ostringstream Buf;
+    Buf.str(std::string());
+    Buf.clear();
+    return Buf;
+  }
+
+  /// SSTDebug: writes Text to File with a single write call
+  static bool __write_file(const std::string& File, const std::string& Text, bool Append){
+    int fd = open(File.c_str(),
+                  O_WRONLY | O_CREAT | O_CLOEXEC | (Append ? O_APPEND : O_TRUNC), 0666);
+    if( fd == -1 )
+      return false;
+    const char *p = Text.data();
+    size_t left = Text.size();
+    while( left > 0 ){
+      ssize_t n = write(fd, p, left);
+      if( n < 0 ){
+        if( errno == EINTR )
+          continue;
+        close(fd);
+        return false;
+      }
+      p += n;
+      left -= n;
+    }
+    return close(fd) == 0;
+  }
+
+  /// SSTDebug: a thread's share of the process-wide counters
+  /// Only the owning thread writes; the totals are read by any thread
+  struct ThreadCounters {
+    std::atomic<uint64_t> Dumps{0};
+    std::atomic<uint64_t> Fields{0};
+    std::atomic<uint64_t> Bytes{0};
+    std::atomic<uint64_t> FormatNs{0};
+    std::atomic<uint64_t> IoNs{0};
+
+    ThreadCounters(){
+      TotalState &T = Totals();
+      std::lock_guard<std::mutex> lock(T.Lock);
+      T.Threads.push_back(this);
+    }
+
+    ~ThreadCounters(){
+      // the counts of a finished thread are kept by the totals
+      TotalState &T = Totals();
+      std::lock_guard<std::mutex> lock(T.Lock);
+      T.Retired += Load();
+      T.Threads.erase(std::remove(T.Threads.begin(), T.Threads.end(), this),
+                      T.Threads.end());
+    }
+
+    static void Bump(std::atomic<uint64_t>& A, uint64_t N){
+      A.store(A.load(std::memory_order_relaxed) + N, std::memory_order_relaxed);
+    }
+
+    void Add(const SSTDebugCounters& C){
+      Bump(Dumps, C.Dumps);
+      Bump(Fields, C.Fields);
+      Bump(Bytes, C.Bytes);
+      Bump(FormatNs, C.FormatNs);
+      Bump(IoNs, C.IoNs);
+    }
+
+    SSTDebugCounters Load() const {
+      SSTDebugCounters C;
+      C.Dumps    = Dumps.load(std::memory_order_relaxed);
+      C.Fields   = Fields.load(std::memory_order_relaxed);
+      C.Bytes    = Bytes.load(std::memory_order_relaxed);
+      C.FormatNs = FormatNs.load(std::memory_order_relaxed);
+      C.IoNs     = IoNs.load(std::memory_order_relaxed);
+      return C;
+    }
+  };
+
+  /// SSTDebug: process-wide counters; live threads and finished ones
+  struct TotalState {
+    std::mutex Lock;                        ///< Guards the thread list
+    std::vector<ThreadCounters *> Threads;  ///< Threads that have dumped
+    SSTDebugCounters Retired;               ///< Counts of finished threads
+  };
+
+  static TotalState& Totals(){
+    static TotalState State;
+    return State;
+  }
+
+  static ThreadCounters& Thread(){
+    thread_local ThreadCounters Counts;
+    return Counts;
+  }
+
+  /// SSTDebug: returns the steady clock in nanoseconds
+  static uint64_t __now(){
+    return (uint64_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  /// SSTDebug: charges the cost of a record to its root and to the calling
+  /// thread; the root has already counted the fields as they were written
+  /// A snapshot child's counts die with it and are not charged
+  void __account(const SSTDebugCounters& C){
+    if( Fork().InSnapshot )
+      return;
+    SSTDebugCounters &R = __root()->Counters;
+    R.Dumps    += C.Dumps;
+    R.Bytes    += C.Bytes;
+    R.FormatNs += C.FormatNs;
+    R.IoNs     += C.IoNs;
+    Thread().Add(C);
+  }
+
+  /// SSTDebug: file receiving the summary record of every component
+  /// (SSTDBG_STATS); `-` selects stderr and an empty name disables it
+  static const std::string& StatsFile(){
+    static const std::string File = [](){
+      const char *Env = std::getenv("SSTDBG_STATS");
+      return std::string(Env == nullptr ? "" : Env);
+    }();
+    return File;
+  }
+
+  /// SSTDebug: writes the summary record of this component's counters
+  void __write_stats(){
+    if( StatsFile().empty() || (Counters.Dumps == 0) )
+      return;
+    std::ostringstream os;
 #ifdef SSTDBG_ASCII
-    // use CSV
-    Bin << Name << "." << v1 << "," << v2 << std::endl;
-#else
-    // use JSON
-    Bin << "," << std::endl << "\"" << v1 << "\": \""
-        << v2 << "\"";
-#endif // #ifdef SSTDBG_ASCII
-#ifdef SSTDBG_ASCII
-    // use CSV
-    Bin << v1 << "," << v2 << std::endl;
+    os << Name << ".Dumps," << Counters.Dumps << std::endl
+       << Name << ".Fields," << Counters.Fields << std::endl
+       << Name << ".Bytes," << Counters.Bytes << std::endl
+       << Name << ".FormatNs," << Counters.FormatNs << std::endl
+       << Name << ".IoNs," << Counters.IoNs << std::endl;
 #else
-    // use JSON
-    Bin << "," << std::endl << "\"" << v1 << "\": \""
-        << v2 << "\"";
+    os << "{" << std::endl
+       << "\"Element\": \"" << Name << "\"," << std::endl
+       << "\"Dumps\": " << Counters.Dumps << "," << std::endl
+       << "\"Fields\": " << Counters.Fields << "," << std::endl
+       << "\"Bytes\": " << Counters.Bytes << "," << std::endl
+       << "\"FormatNs\": " << Counters.FormatNs << "," << std::endl
+       << "\"IoNs\": " << Counters.IoNs << std::endl
+       << "}" << std::endl;
 #endif
-#endif // #ifdef SSTDBG_MPI
-  }
-
-  void SplitStr(const std::string &s, char delim,
-                std::vector<std::string>& v){
-    auto i = 0;
-    auto pos = s.find(delim);
-    if( pos == std::string::npos ){
-      v.push_back(s.substr(i,s.length()));
-    }
-    while( pos != std::string::npos ){
-      v.push_back(s.substr(i,pos-i));
-      i = ++pos;
-      pos = s.find(delim,pos);
-      if( pos == std::string::npos ){
-        v.push_back(s.substr(i,s.length()));
+    if( StatsFile() == "-" )
+      std::cerr << os.str();
+    else
+      __write_file(StatsFile(), os.str(), true);
+  }
+
+  void Register(){
+    ForkState &F = Fork();
+    std::lock_guard<std::mutex> lock(F.Lock);
+    F.Registry.push_back(this);
+  }
+
+  void Unregister(){
+    ForkState &F = Fork();
+    std::lock_guard<std::mutex> lock(F.Lock);
+    F.Registry.erase(std::remove(F.Registry.begin(), F.Registry.end(), this),
+                     F.Registry.end());
+  }
+
+  /// SSTDebug: parses a `pattern:rule[,rule]` sampling entry
+  /// Rules are every=N, prob=P and mod=M
+  static bool ParseSample(const std::string& Entry, SAMPLE& S){
+    auto pos = Entry.rfind(':');
+    if( (pos == std::string::npos) || (pos == 0) )
+      return false;
+    S.Pattern = Entry.substr(0, pos);
+    S.Every = 0;
+    S.Mod = 0;
+    S.Prob = 1.0;
+
+    std::stringstream Rules(Entry.substr(pos+1));
+    std::string Rule;
+    while( std::getline(Rules, Rule, ',') ){
+      auto eq = Rule.find('=');
+      if( eq == std::string::npos )
+        return false;
+      std::string Key = Rule.substr(0, eq);
+      const char *Val = Rule.c_str() + eq + 1;
+      char *End = nullptr;
+      if( Key == "every" )
+        S.Every = (unsigned)(std::strtoul(Val, &End, 10));
+      else if( Key == "mod" )
+        S.Mod = (SSTCYCLE)(std::strtoull(Val, &End, 10));
+      else if( Key == "prob" )
+        S.Prob = std::strtod(Val, &End);
+      else
+        return false;
+      if( (End == Val) || (*End != '\0') )
+        return false;
+    }
+    return true;
+  }
+
+  /// SSTDebug: process-wide sampling rules, read once
+  /// SSTDBG_SAMPLE holds `;` separated entries and SSTDBG_SAMPLE_FILE
+  /// names a file with one entry per line; the first matching entry wins
+  static const std::vector<SAMPLE>& Samples(){
+    static std::vector<SAMPLE> Rules = [](){
+      std::vector<SAMPLE> R;
+      std::vector<std::string> Entries;
+      std::string Entry;
+      if( const char *Env = std::getenv("SSTDBG_SAMPLE") ){
+        std::stringstream ss(Env);
+        while( std::getline(ss, Entry, ';') )
+          Entries.push_back(Entry);
+      }
+      if( const char *File = std::getenv("SSTDBG_SAMPLE_FILE") ){
+        std::ifstream In(File);
+        if( !In.is_open() )
+          std::cerr << "SSTDebug : unable to open the sampling file " << File << std::endl;
+        while( std::getline(In, Entry) )
+          Entries.push_back(Entry);
+      }
+      for( auto& E : Entries ){
+        E.erase(std::remove_if(E.begin(), E.end(), ::isspace), E.end());
+        if( E.empty() || (E[0] == '#') )
+          continue;
+        SAMPLE S;
+        if( ParseSample(E, S) )
+          R.push_back(S);
+        else
+          std::cerr << "SSTDebug : ignoring sampling rule " << E << std::endl;
+      }
+      return R;
+    }();
+    return Rules;
+  }
+
+  /// SSTDebug: applies the first sampling rule that matches this component
+  void InitSampling(){
+    for( const auto& S : Samples() ){
+      if( fnmatch(S.Pattern.c_str(), Name.c_str(), 0) == 0 ){
+        setSampling(S.Every, S.Mod, S.Prob);
+        return;
       }
     }
   }
 
-public:
+  /// SSTDebug: process-wide key filter, read once
+  /// SSTDBG_FILTER holds `,` separated globs over `component.key` and
+  /// SSTDBG_FILTER_FILE names a file with one glob per line; globs
+  /// prefixed with `-` exclude keys and all others include them
+  static const FILTER& Filter(){
+    static FILTER F = [](){
+      FILTER R;
+      std::vector<std::string> Entries;
+      std::string Entry;
+      if( const char *Env = std::getenv("SSTDBG_FILTER") ){
+        std::stringstream ss(Env);
+        while( std::getline(ss, Entry, ',') )
+          Entries.push_back(Entry);
+      }
+      if( const char *File = std::getenv("SSTDBG_FILTER_FILE") ){
+        std::ifstream In(File);
+        if( !In.is_open() )
+          std::cerr << "SSTDebug : unable to open the filter file " << File << std::endl;
+        while( std::getline(In, Entry) )
+          Entries.push_back(Entry);
+      }
+      for( auto& E : Entries ){
+        E.erase(std::remove_if(E.begin(), E.end(), ::isspace), E.end());
+        if( E.empty() || (E[0] == '#') )
+          continue;
+        unsigned Kind = 0;
+        if( (E[0] == '-') || (E[0] == '+') ){
+          Kind = (E[0] == '-') ? 1 : 0;
+          E.erase(0, 1);
+        }
+        // patterns without wildcards are matched with a single lookup
+        if( E.find_first_of("*?[") == std::string::npos )
+          R.Exact[Kind].insert(E);
+        else
+          R.Globs[Kind].push_back(E);
+      }
+      return R;
+    }();
+    return F;
+  }
 
-  /// SSTDebug: SST Debug constructor
-  SSTDebug()
-    : Name("SSTDBG"), Path("./"){
+  /// SSTDebug: enables the key filter if any rules were given
+  void InitFilter(){
+    const FILTER& F = Filter();
+    Filtered = !F.Exact[0].empty() || !F.Exact[1].empty() ||
+               !F.Globs[0].empty() || !F.Globs[1].empty();
   }
 
-  /// SSTDebug: SST Debug overloaded constructor
-  SSTDebug(std::string Name)
-    : Name(Name), Path("./"){
+  /// SSTDebug: does the filter keep this component's Key?
+  bool __match_key(const std::string& Key){
+    const FILTER& F = Filter();
+    const std::string Full = __root()->Name + "." + ScopePath + Key;
+    auto Match = [&](unsigned Kind){
+      if( F.Exact[Kind].count(Full) )
+        return true;
+      for( const auto& G : F.Globs[Kind] ){
+        if( fnmatch(G.c_str(), Full.c_str(), 0) == 0 )
+          return true;
+      }
+      return false;
+    };
+    const bool Includes = !F.Exact[0].empty() || !F.Globs[0].empty();
+    return (!Includes || Match(0)) && !Match(1);
   }
 
-  /// SSTDebug: SST Debug overloaded constructor
-  SSTDebug(std::string Name, std::string Path)
-    : Name(Name), Path(Path){
+  /// SSTDebug: filter decision for a key name; cached by the name so
+  /// the globs are matched once per key rather than once per dump
+  bool __keep_name(const std::string& Key){
+    auto it = KeyCache.find(Key);
+    if( it != KeyCache.end() )
+      return it->second;
+    bool Keep = __match_key(Key);
+    KeyCache.emplace(Key, Keep);
+    return Keep;
   }
 
-  /// SSTDebug: SST Debug destructor
-  ~SSTDebug(){}
+  /// SSTDebug: filter decision for a key
+  bool __keep(const char *Key){
+    if( !Filtered )
+      return true;
+    return __keep_name(Key);
+  }
 
-  /// SSTDebug: SST Debug data dump function
-  template<typename T, typename U, typename... Args>
-  bool dump(SSTCYCLE cycle, T t, U u, Args... args){
+  /// SSTDebug: filter decision for any other key type
+  template<typename K>
+  bool __keep(const K& Key){
+    if( !Filtered )
+      return true;
+    std::ostringstream ss;
+    ss << Key;
+    return __keep_name(ss.str());
+  }
 
-//---------------------------------------------------------------
-// MPI DUMP
-//---------------------------------------------------------------
-#ifdef SSTDBG_MPI
-    int rank    = -1;
-    int isInit  = -1;
-    MPI_Initialized(&isInit);
-    if( isInit ){
-      // MPI is initialized
-      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  /// SSTDebug: determines whether the dump of this cycle is written
+  /// In fork mode the rule is applied at the object's own dump call in the
+  /// parent; the snapshot child is only sent the cycles that were kept, so
+  /// it does not apply the rule (or advance its state) a second time
+  bool __sample(SSTCYCLE cycle){
+    if( !Sampled || Fork().InSnapshot )
+      return true;
+    if( Mod && (cycle % Mod) )
+      return false;
+    if( Every && ((Calls++ % Every) != 0) )
+      return false;
+    if( ProbCut < (1ull << 32) ){
+      Rng ^= Rng << 13;
+      Rng ^= Rng >> 7;
+      Rng ^= Rng << 17;
+      return (Rng >> 32) < ProbCut;
+    }
+    return true;
+  }
+
+#ifdef SSTDBG_SHM
+  /// SSTDebug: process-wide shared memory ring sink
+  struct ShmState {
+    SSTDebugRing Ring;      ///< Mapped ring; closed if the sink is disabled
+    bool Tee = false;       ///< Also write the dump files?
+
+    ShmState(){
+      // SSTDBG_SHM=/name selects the ring; SSTDBG_SHM_MB sizes it when
+      // it is created and SSTDBG_SHM_TEE=1 keeps the file output as well
+      const char *Env = std::getenv("SSTDBG_SHM");
+      if( (Env == nullptr) || (*Env == '\0') )
+        return;
+      uint64_t MB = 64;
+      if( const char *Size = std::getenv("SSTDBG_SHM_MB") )
+        MB = std::strtoull(Size, nullptr, 10);
+      if( !Ring.Open(Env, MB << 20) )
+        std::cerr << "SSTDebug : unable to open the shared memory ring " << Env << std::endl;
+      const char *TeeEnv = std::getenv("SSTDBG_SHM_TEE");
+      Tee = (TeeEnv != nullptr) && (std::string(TeeEnv) != "0");
+    }
+
+    ~ShmState(){
+      // an attached console removes the name once it has drained the ring
+      if( Ring.IsOwner() && !Ring.HasConsumer() )
+        Ring.Unlink();
+    }
+  };
+
+  static ShmState& Shm(){
+    static ShmState State;
+    return State;
+  }
+#endif
 
+  /// SSTDebug: writes the record preamble
+  void __begin_record(std::ostream& os, SSTCYCLE cycle, int rank){
 #ifdef SSTDBG_ASCII
-      std::string BinName = "SSTDbg." + std::to_string(rank) + "." + std::to_string(cycle) + ".out";
+    // records in shared (MPI) files are introduced by their component
+    if( rank != -1 )
+      os << "#Element," << Name << std::endl;
 #else
-      std::string BinName = "SSTDbg." + std::to_string(rank) + "." + std::to_string(cycle) + ".json";
+    os << "{" << std::endl;
+    os << "\"Element\": \"" << Name << "\"," << std::endl;
+    os << "\"Cycle\": " << cycle;
 #endif
-      Bin.open(BinName.c_str(), std::ios::out|std::ios_base::app);
-      if( !Bin.is_open() )
-        return false;
+  }
 
+  /// SSTDebug: writes the record trailer
+  void __end_record(std::ostream& os){
+#ifndef SSTDBG_ASCII
+    os << std::endl << "}" << std::endl;
+#endif
+  }
+
+  /// SSTDebug: value kinds; 0 = scalar, 1 = array or container, 2 = pair
+  template<typename T>
+  using __kind = std::integral_constant<int, SSTDebugIsPair<T>::value ? 2 :
+                                             SSTDebugIsSeq<T>::value ? 1 : 0>;
+
+  /// SSTDebug: writes a scalar container element
+  /// JSON numbers are written bare; everything else is quoted
+  template<typename T>
+  static void __write_scalar(std::ostream& os, const T& v){
 #ifdef SSTDBG_ASCII
-      // CSV
-      Bin << Name << "." << t << "," << u << std::endl;
+    os << v;
 #else
-      // JSON
-      Bin << "{" << std::endl;
-      Bin << "\"Element\": \"" << Name << "\"," << std::endl;
-      Bin << "\"Cycle\": " << cycle;
-      Bin << "," << std::endl << "\"" << t << "\": \""
-          << u << "\"";
+    if( std::is_arithmetic<T>::value )
+      os << v;
+    else
+      os << "\"" << v << "\"";
 #endif
+  }
 
-      __internal_dump(args...);
+  static void __write_scalar(std::ostream& os, char v){
+#ifdef SSTDBG_ASCII
+    os << v;
+#else
+    os << "\"" << v << "\"";
+#endif
+  }
+
+  static void __write_scalar(std::ostream& os, signed char v){ os << (int)(v); }
+  static void __write_scalar(std::ostream& os, unsigned char v){ os << (unsigned)(v); }
 
+  static void __write_scalar(std::ostream& os, double v){
 #ifndef SSTDBG_ASCII
-      Bin << std::endl << "}" << std::endl;
+    // inf and nan are not JSON numbers
+    if( !std::isfinite(v) ){
+      os << "\"" << v << "\"";
+      return;
+    }
 #endif
-    }else{
-      // MPI is not initialized, run the sequential (per file) output
+    os << v;
+  }
+
+  static void __write_scalar(std::ostream& os, float v){ __write_scalar(os, (double)(v)); }
+
+  /// SSTDebug: writes an array or container element
+  template<typename T>
+  static void __write_elem(std::ostream& os, const T& v){
+    __write_elem(os, v, __kind<T>());
+  }
+
+  template<typename T>
+  static void __write_elem(std::ostream& os, const T& v, std::integral_constant<int,0>){
+    __write_scalar(os, v);
+  }
+
+  /// SSTDebug: writes an array or container as a single compact value
+  /// JSON uses [a,b]; ASCII uses [a;b] so the value stays in one CSV field
+  template<typename T>
+  static void __write_elem(std::ostream& os, const T& v, std::integral_constant<int,1>){
 #ifdef SSTDBG_ASCII
-      std::string BinName = Name + "." + std::to_string(cycle) + ".out";
+    const char Sep = ';';
 #else
-      std::string BinName = Name + "." + std::to_string(cycle) + ".json";
+    const char Sep = ',';
 #endif
-      Bin.open(BinName.c_str(), std::ios::out);
-      if( !Bin.is_open() )
-        return false;
+    os << "[";
+    bool First = true;
+    for( auto const& e : v ){
+      if( !First )
+        os << Sep;
+      __write_elem(os, e);
+      First = false;
+    }
+    os << "]";
+  }
 
+  /// SSTDebug: writes a pair (e.g., a map entry); JSON [k,v], ASCII k=v
+  template<typename T>
+  static void __write_elem(std::ostream& os, const T& v, std::integral_constant<int,2>){
 #ifdef SSTDBG_ASCII
-      // CSV
-      Bin << t << "," << u << std::endl;
+    __write_elem(os, v.first);
+    os << "=";
+    __write_elem(os, v.second);
 #else
-      // JSON
-      Bin << "{" << std::endl;
-      Bin << "\"Element\": \"" << Name << "\"," << std::endl;
-      Bin << "\"Cycle\": " << cycle;
-      Bin << "," << std::endl << "\"" << t << "\": \""
-          << u << "\"";
+    os << "[";
+    __write_elem(os, v.first);
+    os << ",";
+    __write_elem(os, v.second);
+    os << "]";
 #endif
+  }
 
-      __internal_dump(args...);
+  /// SSTDebug: writes a dumped value
+  /// Scalars keep the quoted JSON string format; arrays and containers
+  /// are written as one compact value
+  template<typename T>
+  static void __write_value(std::ostream& os, const T& v){
+    __write_value(os, v, std::integral_constant<bool, (__kind<T>::value == 0)>());
+  }
 
-#ifndef SSTDBG_ASCII
-      Bin << std::endl << "}" << std::endl;
+  template<typename T>
+  static void __write_value(std::ostream& os, const T& v, std::true_type){
+#ifdef SSTDBG_ASCII
+    os << v;
+#else
+    os << "\"" << v << "\"";
+#endif
+  }
+
+  template<typename T>
+  static void __write_value(std::ostream& os, const T& v, std::false_type){
+    __write_elem(os, v);
+  }
+
+  template<typename T, typename U, typename... Args>
+  void __internal_dump(std::ostream& os, T t, const U& u, const Args&... args){
+    __internal_dump(os,t,u);
+    __internal_dump(os,args...);
+  }
+
+  void __internal_dump(std::ostream& os){
+  }
+
+  /// SSTDebug: writes a single name/value pair
+  template<typename T1, typename T2>
+  void __internal_dump(std::ostream& os, T1 v1, const T2& v2){
+    // keys removed by the filter are never formatted
+    if( !__keep(v1) )
+      return;
+    __root()->Counters.Fields++;
+#ifdef SSTDBG_ASCII
+    // use CSV
+    os << ScopePath << v1 << ",";
+    __write_value(os, v2);
+    os << std::endl;
+#else
+    // use JSON
+    os << "," << std::endl << "\"" << v1 << "\": ";
+    __write_value(os, v2);
+#endif
+  }
+
+  /// SSTDebug: returns the preformatted key of a watch variable
+  std::string __watch_key(const std::string& Key){
+#ifdef SSTDBG_ASCII
+    return ScopePath + Key + ",";
+#else
+    return ",\n\"" + Key + "\": ";
+#endif
+  }
+
+  /// SSTDebug: writes element i of staged POD data
+  template<typename T>
+  static void __watch_value(std::ostream& os, const void* Src, size_t i, bool Elem,
+                            std::true_type){
+    T v;
+    std::memcpy(&v, (const uint8_t *)(Src) + i*sizeof(T), sizeof(T));
+    if( Elem )
+      __write_elem(os, v);
+    else
+      __write_value(os, v);
+  }
+
+  /// SSTDebug: writes element i of live non-POD storage
+  template<typename T>
+  static void __watch_value(std::ostream& os, const void* Src, size_t i, bool Elem,
+                            std::false_type){
+    const T& v = ((const T *)(Src))[i];
+    if( Elem )
+      __write_elem(os, v);
+    else
+      __write_value(os, v);
+  }
+
+  /// SSTDebug: writes a watch variable of type T; arrays are one value
+  /// Src is the staged copy of POD data or the live storage otherwise
+  template<typename T>
+  static void __format_watch(std::ostream& os, const void* Src,
+                             const WATCH& W){
+    os << W.Key;
+    if( W.Count == 1 ){
+      __watch_value<T>(os, Src, 0, false, std::is_trivially_copyable<T>());
+    }else{
+#ifdef SSTDBG_ASCII
+      const char Sep = ';';
+#else
+      const char Sep = ',';
+#endif
+      os << "[";
+      for( size_t i=0; i<W.Count; i++ ){
+        if( i )
+          os << Sep;
+        __watch_value<T>(os, Src, i, true, std::is_trivially_copyable<T>());
+      }
+      os << "]";
+    }
+#ifdef SSTDBG_ASCII
+    os << "\n";
+#endif
+  }
+
+  /// SSTDebug: returns the record root of a scope
+  SSTDebug* __root(){
+    SSTDebug *R = this;
+    while( R->Parent != nullptr )
+      R = R->Parent;
+    return R;
+  }
+
+  /// SSTDebug: captures the watched POD state in one pass, then formats
+  /// every watch variable from the copy
+  void __format_watches(std::ostream& os){
+    __root()->Counters.Fields += Watches.size();
+    uint8_t *Base = Stage.data();
+    for( const auto& W : Watches ){
+      if( W.Bytes )
+        std::memcpy(Base + W.Offset, W.Ptr, W.Bytes);
+    }
+    for( const auto& W : Watches )
+      W.Format(os, W.Bytes ? (const void *)(Base + W.Offset) : W.Ptr, W);
+  }
+
+  /// SSTDebug: holds a scope's formatted values for the root's next record
+  /// Values of an older cycle are replaced
+  void __stash(SSTCYCLE cycle, const std::string& Text){
+    if( !HasPending || (PendingCycle != cycle) ){
+      Pending.clear();
+      PendingCycle = cycle;
+      HasPending   = true;
+      Watched      = false;
+    }
+    Pending += Text;
+  }
+
+  /// SSTDebug: writes the pending values of every child scope
+  /// JSON nests each scope as an object; ASCII names carry the scope path.
+  /// Values pending from an older cycle are written with their own Cycle.
+  void __append_scopes(std::ostream& os, SSTCYCLE cycle){
+    for( auto& S : Scopes ){
+      // watch variables of a scope are captured with the record
+      if( !S->Watches.empty() &&
+          !(S->HasPending && S->Watched && (S->PendingCycle == cycle)) ){
+        std::ostringstream W;
+        S->__format_watches(W);
+        S->__stash(cycle, W.str());
+        S->Watched = true;
+      }
+
+      std::ostringstream Body;
+      if( S->HasPending && (S->PendingCycle != cycle) ){
+#ifdef SSTDBG_ASCII
+        Body << S->ScopePath << "Cycle," << S->PendingCycle << std::endl;
+#else
+        Body << "," << std::endl << "\"Cycle\": " << S->PendingCycle;
+#endif
+      }
+      Body << S->Pending;
+      S->__append_scopes(Body, cycle);
+      S->Pending.clear();
+      S->HasPending = false;
+      S->Watched = false;
+
+      const std::string Text = Body.str();
+      if( Text.empty() )
+        continue;
+#ifdef SSTDBG_ASCII
+      os << Text;
+#else
+      // drop the leading separator of the first value
+      os << "," << std::endl << "\"" << S->Name << "\": {" << std::endl
+         << Text.substr(2) << std::endl << "}";
 #endif
     }
+  }
+
+  /// SSTDebug: returns the MPI rank writing the dump; -1 for per component files
+  int __rank(){
+#ifdef SSTDBG_MPI
+    return Rank();
+#else
+    return -1;
+#endif
+  }
+
+  /// SSTDebug: hands a formatted record to the shared memory ring and/or
+  /// the dump file
+  bool __write_record(SSTCYCLE cycle, int rank, const std::string& Text){
 
 //---------------------------------------------------------------
-// NON-MPI DUMP
+// SHARED MEMORY DUMP
+//---------------------------------------------------------------
+#ifdef SSTDBG_SHM
+    // records are published to the ring; the files are only written
+    // when the tee is enabled
+    ShmState &S = Shm();
+    if( S.Ring.IsOpen() ){
+      bool rtn = S.Ring.Write(Name, cycle, Text);
+      if( !S.Tee )
+        return rtn;
+    }
+#endif
+
+//---------------------------------------------------------------
+// FILE DUMP
 //---------------------------------------------------------------
-#else
-    // MPI builds were disabled, write out one file per component
 #ifdef SSTDBG_ASCII
-    std::string BinName = Name + "." + std::to_string(cycle) + ".out";
+    const std::string Ext = ".out";
 #else
-    std::string BinName = Name + "." + std::to_string(cycle) + ".json";
+    const std::string Ext = ".json";
 #endif
-    Bin.open(BinName.c_str(), std::ios::out);
-    if( !Bin.is_open() )
+    if( rank != -1 ){
+      // MPI is initialized; every thread of a rank appends whole records
+      // to its own shard per cycle, so threads never share a file
+      std::string BinName = "SSTDbg." + std::to_string(rank) + ".t" + std::to_string(Shard()) +
+                            "." + std::to_string(cycle) + Ext;
+      return __write_file(__path(BinName), Text, true);
+    }
+
+    // sequential (per component) output
+    std::string BinName = Name + "." + std::to_string(cycle) + Ext;
+    return __write_file(__path(BinName), Text, false);
+  }
+
+  /// SSTDebug: writes a formatted record and charges its cost
+  /// Start is the time formatting began and Fields the root's field count then
+  bool __issue_record(SSTCYCLE cycle, int rank, const std::string& Text,
+                      uint64_t Start, uint64_t Fields){
+    const uint64_t Formatted = __now();
+    bool rtn = __write_record(cycle, rank, Text);
+    SSTDebugCounters C;
+    C.Dumps    = 1;
+    C.Fields   = Counters.Fields - Fields;
+    C.Bytes    = rtn ? Text.size() : 0;
+    C.FormatNs = Formatted - Start;
+    C.IoNs     = __now() - Formatted;
+    __account(C);
+    return rtn;
+  }
+
+  /// SSTDebug: returns the path joined with the file name
+  std::string __path(const std::string& File){
+    if( Path.empty() )
+      return File;
+    if( Path.back() == '/' )
+      return Path + File;
+    return Path + "/" + File;
+  }
+
+  /// SSTDebug: nested scope constructor
+  /// Scopes are not registered for fork mode; the root writes their values
+  SSTDebug(SSTDebug *P, const std::string& ScopeName)
+    : Name(ScopeName), Path(P->Path), Parent(P),
+      ScopePath(P->ScopePath + ScopeName + "/"){
+    InitFilter();
+  }
+
+  /// SSTDebug: returns the per-thread shard files (SSTDbg.RANK.tN.CYCLE) of a cycle
+  std::vector<std::string> __shards(SSTCYCLE Cycle, const std::string& Ext){
+    std::vector<std::string> v;
+    const std::string Suffix = "." + std::to_string(Cycle) + Ext;
+    DIR *dir;
+    struct dirent *ent;
+    if((dir = opendir(Path.c_str())) != NULL){
+      while((ent = readdir(dir)) != NULL){
+        std::string tmp(ent->d_name);
+        if( (tmp.compare(0, 7, "SSTDbg.") == 0) && (tmp.size() > Suffix.size()) &&
+            (tmp.compare(tmp.size()-Suffix.size(), Suffix.size(), Suffix) == 0) )
+          v.push_back(tmp);
+      }
+      closedir(dir);
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+  }
+
+  /// SSTDebug: splits a dump file name, Component.Cycle.Ext; false for other files
+  static bool __dump_name(const std::string& File, const std::string& Ext,
+                          std::string& Component, SSTCYCLE& Cycle){
+    if( (File.size() <= Ext.size()) ||
+        (File.compare(File.size()-Ext.size(), Ext.size(), Ext) != 0) )
+      return false;
+    const std::string Stem = File.substr(0, File.size()-Ext.size());
+    auto pos = Stem.rfind('.');
+    if( (pos == std::string::npos) || (pos == 0) || (pos+1 == Stem.size()) )
       return false;
+    const std::string C = Stem.substr(pos+1);
+    if( !std::all_of(C.begin(), C.end(), ::isdigit) )
+      return false;
+    Component = Stem.substr(0,pos);
+    Cycle = std::strtoull(C.c_str(), nullptr, 10);
+    return true;
+  }
 
+  /// SSTDebug: returns the components with records in a shard file
+  /// JSON records carry their Element, ASCII records an #Element line
+  std::vector<std::string> __shard_components(const std::string& Shard){
+    std::vector<std::string> v;
+    std::ifstream Input(__path(Shard).c_str());
+    std::string line;
 #ifdef SSTDBG_ASCII
-    // CSV
-    Bin << t << "," << u << std::endl;
+    const std::string Key = "#Element,";
+    while( std::getline(Input,line) ){
+      if( line.compare(0, Key.size(), Key) == 0 )
+        v.push_back(line.substr(Key.size()));
+    }
 #else
-    // JSON
-    Bin << "{" << std::endl;
-    Bin << "\"Element\": \"" << Name << "\"," << std::endl;
-    Bin << "\"Cycle\": " << cycle;
-    Bin << "," << std::endl << "\"" << t << "\": \""
-        << u << "\"";
+    // the Element follows the opening brace of every record
+    const std::string Key = "\"Element\": \"";
+    bool Open = false;
+    while( std::getline(Input,line) ){
+      if( Open && (line.compare(0, Key.size(), Key) == 0) ){
+        auto end = line.rfind('\"');
+        if( end >= Key.size() )
+          v.push_back(line.substr(Key.size(), end-Key.size()));
+      }
+      Open = (line == "{");
+    }
 #endif
+    return v;
+  }
 
-    __internal_dump(args...);
-
-#ifndef SSTDBG_ASCII
-    Bin << std::endl << "}" << std::endl;
+  /// SSTDebug: calls Fn(Component, Cycle) for every dump in the run directory
+  /// With Expand, a shard is reported once per component of its records
+  template<typename F>
+  void __scan_dumps(bool Expand, F Fn){
+#ifdef SSTDBG_ASCII
+    const std::string Ext = ".out";
+#else
+    const std::string Ext = ".json";
 #endif
-#endif  // #ifdef SSTDBG_MPI
+    DIR *dir;
+    struct dirent *ent;
+    if((dir = opendir(Path.c_str())) != NULL){
+      while((ent = readdir(dir)) != NULL){
+        std::string tmp(ent->d_name);
+        std::string Component;
+        SSTCYCLE Cycle = 0;
+        if( !__dump_name(tmp, Ext, Component, Cycle) )
+          continue;
+        if( Expand && (tmp.compare(0, 7, "SSTDbg.") == 0) ){
+          for( auto const& C : __shard_components(tmp) )
+            Fn(C, Cycle);
+        }else{
+          Fn(Component, Cycle);
+        }
+      }
+      closedir(dir);
+    }
+  }
 
-    // all versions close the file
-    Bin.close();
+  /// SSTDebug: reads the `key,value` lines of an ASCII dump; a shared file
+  /// holds records introduced by `#Element,Component` lines and only those
+  /// of Component are kept
+  void __read_ascii(std::istream& Input, const std::string& Component, SSTVALUE& v){
+    const std::string Key = "#Element,";
+    bool Keep = Component.empty();
+    std::string line;
+    while( std::getline(Input,line) ){
+      if( line.compare(0, Key.size(), Key) == 0 ){
+        Keep = (line.compare(Key.size(), std::string::npos, Component) == 0);
+        continue;
+      }
+      if( !Keep )
+        continue;
+      // split the line at the first comma: CSV format
+      auto pos = line.find(',');
+      if( pos != std::string::npos ){
+        v.push_back(std::pair<std::string,std::string>(line.substr(0,pos),
+                                                       line.substr(pos+1)));
+      }
+    }
+  }
 
-    return true;
+  /// SSTDebug: reads the records of a JSON dump; a shared file holds
+  /// consecutive records and only those whose Element is Component are kept
+  void __read_json(std::istream& Input, const std::string& Component, SSTVALUE& v){
+    std::string line;
+    while( std::getline(Input,line) ){
+      // every record starts with an opening brace
+      if( line != "{" )
+        return;
+
+      // nested scopes are returned as scope/key names
+      SSTVALUE Rec;
+      std::vector<std::string> Scope;
+      bool Closed = false;
+      while( !Closed && std::getline(Input,line) ){
+        if( (line == "}") || (line == "},") ){
+          if( Scope.empty() )
+            Closed = true;
+          else
+            Scope.pop_back();
+          continue;
+        }
+        // split the line at the first `": ` so values may hold colons and
+        // commas (e.g., arrays); the trailing separator and quotes are removed
+        auto pos = line.find("\": ");
+        if( (pos == std::string::npos) || (line[0] != '\"') )
+          continue;
+        std::string Key = line.substr(1,pos-1);
+        std::string Val = line.substr(pos+3);
+        if( Val == "{" ){
+          Scope.push_back(Key);
+          continue;
+        }
+        if( !Val.empty() && (Val.back() == ',') )
+          Val.pop_back();
+        if( (Val.size() >= 2) && (Val.front() == '\"') && (Val.back() == '\"') )
+          Val = Val.substr(1,Val.size()-2);
+        std::string Name;
+        for( auto const& S : Scope )
+          Name += S + "/";
+        Rec.push_back(std::pair<std::string,std::string>(Name + Key,Val));
+      }
+
+      if( !Rec.empty() && (Rec[0].first == "Element") && (Rec[0].second == Component) )
+        v.insert(v.end(), Rec.begin(), Rec.end());
+    }
+  }
+
+public:
+
+  /// SSTDebug: SST Debug constructor
+  SSTDebug()
+    : Name("SSTDBG"), Path("./"){
+    Register();
+    InitSampling();
+    InitFilter();
+  }
+
+  /// SSTDebug: SST Debug overloaded constructor
+  SSTDebug(std::string Name)
+    : Name(Name), Path("./"){
+    Register();
+    InitSampling();
+    InitFilter();
+  }
+
+  /// SSTDebug: SST Debug overloaded constructor
+  SSTDebug(std::string Name, std::string Path)
+    : Name(Name), Path(Path){
+    Register();
+    InitSampling();
+    InitFilter();
+  }
+
+  /// SSTDebug: SST Debug destructor
+  ~SSTDebug(){
+    Unregister();
+    if( Parent == nullptr )
+      __write_stats();
+  }
+
+  /// SSTDebug: SST Debug returns the nested scope ScopeName, creating it if needed
+  /// Values dumped to a scope are written as part of the root's next
+  /// record rather than to a file of their own
+  SSTDebug* scope(const std::string& ScopeName){
+    for( auto& S : Scopes ){
+      if( S->Name == ScopeName )
+        return S.get();
+    }
+    Scopes.emplace_back(new SSTDebug(this, ScopeName));
+    return Scopes.back().get();
+  }
+
+  /// SSTDebug: SST Debug determines whether this object is a nested scope
+  bool IsScope(){ return Parent != nullptr; }
+
+  /// SSTDebug: SST Debug set the sampling policy
+  /// Writes every Nth dump call (0 writes all), only the cycles divisible
+  /// by CycleMod (0 writes all) and each remaining dump with probability Prob
+  void setSampling(unsigned N, SSTCYCLE CycleMod = 0, double Prob = 1.0){
+    Every   = (N > 1) ? N : 0;
+    Mod     = CycleMod;
+    Calls   = 0;
+    ProbCut = (Prob >= 1.0) ? (1ull << 32) :
+              (Prob <= 0.0) ? 0 : (uint64_t)(Prob * 4294967296.0);
+    Rng     = std::hash<std::string>()(Name) | 1;
+    Sampled = (Every != 0) || (Mod != 0) || (ProbCut < (1ull << 32));
+  }
+
+  /// SSTDebug: SST Debug set the snapshot callback used by fork mode
+  /// The callback performs this object's dump for the target cycle
+  /// (generally the same dump call made from printStatus)
+  void setSnapshot(std::function<void(SSTCYCLE)> F){ Snapshot = F; }
+
+  /// SSTDebug: SST Debug enable fork mode with at most MaxChildren
+  /// concurrent snapshot children; 0 disables fork mode
+  static void setForkMode(unsigned MaxChildren){ Fork().MaxChildren = MaxChildren; }
+
+  /// SSTDebug: SST Debug determines whether fork mode is enabled
+  static bool IsForkMode(){ return Fork().MaxChildren > 0; }
+
+  /// SSTDebug: SST Debug wait for all outstanding snapshot children
+  static void waitSnapshots(){
+    std::lock_guard<std::mutex> lock(Fork().Lock);
+    EndEpoch();
+    ReapSnapshots(1);
+  }
+
+  /// SSTDebug: SST Debug data dump function
+  template<typename T, typename U, typename... Args>
+  bool dump(SSTCYCLE cycle, T t, const U& u, const Args&... args){
+
+    // nested scopes hand their values to the root's next record
+    if( Parent != nullptr ){
+      const uint64_t Start  = __now();
+      const uint64_t Fields = __root()->Counters.Fields;
+      std::ostringstream Vals;
+      __internal_dump(Vals, t, u, args...);
+      __stash(cycle, Vals.str());
+      SSTDebugCounters C;
+      C.Fields   = __root()->Counters.Fields - Fields;
+      C.FormatNs = __now() - Start;
+      __account(C);
+      return true;
+    }
+
+    // skipped by the sampling policy
+    const bool Keep = __sample(cycle);
+
+//---------------------------------------------------------------
+// FORK DUMP
+//---------------------------------------------------------------
+    // In fork mode the first dump of an epoch forks the process; each
+    // registered object's dump hands its cycle to the child, which writes
+    // the object's snapshot while the parent resumes
+    if( Snapshot && !Fork().InSnapshot && IsForkMode() ){
+      if( ForkSnapshot(this, cycle, Keep) )
+        return true;
+    }
+    if( !Keep )
+      return true;
+
+    // format the record once; it is then handed to each sink
+    const uint64_t Start  = __now();
+    const uint64_t Fields = Counters.Fields;
+    int rank = __rank();
+    std::ostringstream& Rec = __buffer();
+    __begin_record(Rec, cycle, rank);
+    __internal_dump(Rec, t, u, args...);
+    __append_scopes(Rec, cycle);
+    __end_record(Rec);
+    return __issue_record(cycle, rank, Rec.str(), Start, Fields);
+  }
+
+  /// SSTDebug: SST Debug register a watch variable dumped by snapshot()
+  /// Count elements are read from Ptr; arrays are written as one value
+  /// The storage must remain valid for the lifetime of this object
+  template<typename T>
+  void watch(const std::string& WName, const T* Ptr, size_t Count = 1){
+    // filtered watch variables are neither copied nor formatted
+    if( Filtered && !__match_key(WName) )
+      return;
+    WATCH W;
+    W.Ptr    = (const void *)(Ptr);
+    W.Count  = Count;
+    W.Bytes  = std::is_trivially_copyable<T>::value ? (sizeof(T) * Count) : 0;
+    W.Offset = Stage.size();
+    W.Format = &SSTDebug::__format_watch<T>;
+    W.Key    = __watch_key(WName);
+    // keep every staged region aligned for its element type
+    Stage.resize(W.Offset + ((W.Bytes + 7) & ~(size_t)(7)));
+    Watches.push_back(std::move(W));
+    SnapshotMode = true;
+  }
+
+  /// SSTDebug: SST Debug register a fixed size array watch variable
+  /// Count is the number of elements watched; at most the array's size
+  template<typename T, size_t N>
+  void watch(const std::string& WName, const T (*Ptr)[N], size_t Count = N){
+    watch(WName, &(*Ptr)[0], std::min(Count, N));
+  }
+
+  /// SSTDebug: SST Debug dump every registered watch variable
+  /// A root's record also holds the values of all of its scopes
+  bool snapshot(SSTCYCLE cycle){
+    if( Parent != nullptr ){
+      const uint64_t Start  = __now();
+      std::ostringstream Vals;
+      __format_watches(Vals);
+      __stash(cycle, Vals.str());
+      Watched = true;
+      SSTDebugCounters C;
+      C.Fields   = Watches.size();
+      C.FormatNs = __now() - Start;
+      __account(C);
+      return true;
+    }
+
+    SnapshotMode = true;
+    const bool Keep = __sample(cycle);
+
+    // watch variables make this object snapshot capable in fork mode
+    if( !Fork().InSnapshot && IsForkMode() ){
+      if( ForkSnapshot(this, cycle, Keep) )
+        return true;
+    }
+    if( !Keep )
+      return true;
+
+    const uint64_t Start  = __now();
+    const uint64_t Fields = Counters.Fields;
+    int rank = __rank();
+    std::ostringstream& Rec = __buffer();
+    __begin_record(Rec, cycle, rank);
+    __format_watches(Rec);
+    __append_scopes(Rec, cycle);
+    __end_record(Rec);
+    return __issue_record(cycle, rank, Rec.str(), Start, Fields);
+  }
+
+  /// SSTDebug: SST Debug number of registered watch variables
+  size_t getWatchCount(){ return Watches.size(); }
+
+  /// SSTDebug: SST Debug retrieve the cost of this component's records
+  /// The records of nested scopes are charged to their root
+  SSTDebugCounters GetCounters(){ return __root()->Counters; }
+
+  /// SSTDebug: SST Debug retrieve the cost of every record of the process
+  static SSTDebugCounters GetTotalCounters(){
+    TotalState &T = Totals();
+    std::lock_guard<std::mutex> lock(T.Lock);
+    SSTDebugCounters C = T.Retired;
+    for( auto *Th : T.Threads )
+      C += Th->Load();
+    return C;
   }
 
 
@@ -245,204 +1535,89 @@ public:
 
   /// SSTDebug: SST Debug retrieve the set of current clock values
   std::vector<SSTCYCLE> GetClockVals(){
-    DIR *dir;
-    struct dirent *ent;
-#ifdef SSTDBG_ASCII
-    std::string delim = ".out";
-#else
-    std::string delim = ".json";
-#endif
     std::vector<SSTCYCLE> v;
-
-    if((dir = opendir(Path.c_str())) != NULL){
-      while((ent = readdir(dir)) != NULL){
-        std::string tmp(ent->d_name);
-        if(tmp.find(delim.c_str()) != std::string::npos){
-          // positive match, split the name
-          std::vector<std::string> TmpV;
-          SplitStr(tmp,'.',TmpV);
-
-          // get the second to last vector element
-          // this is where the clock cycle is stored
-          if( TmpV.size() >= 3 ){
-            v.push_back(std::stoi(TmpV[TmpV.size()-2]));
-          }
-        }
-      }
-      closedir(dir);
-    }
+    __scan_dumps(false, [&](const std::string&, SSTCYCLE Cycle){
+      v.push_back(Cycle);
+    });
 
     // make the vector unique
+    std::sort(v.begin(), v.end());
     v.erase( std::unique( v.begin(), v.end() ), v.end() );
 
     return v;
   }
 
   /// SSTDebug: SST Debug retrieve the set of current output clocks for the target component
+  /// The records of the per-thread shards of an MPI rank are included
   std::vector<SSTCYCLE> GetClockValsByComponent(std::string Component){
-    DIR *dir;
-    struct dirent *ent;
-#ifdef SSTDBG_ASCII
-    std::string delim = ".out";
-#else
-    std::string delim = ".json";
-#endif
     std::vector<SSTCYCLE> v;
-
-    if((dir = opendir(Path.c_str())) != NULL){
-      while((ent = readdir(dir)) != NULL){
-        std::string tmp(ent->d_name);
-        if(tmp.find(delim.c_str()) != std::string::npos){
-          // positive match, split the name
-          std::vector<std::string> TmpV;
-          SplitStr(tmp,'.',TmpV);
-
-          // we have the vector of tokens,
-          // concat everything until we find an integer
-          std::string FinalStr;
-          unsigned i = 0;
-          unsigned pos = 0;
-          while( (i<TmpV.size()) &&
-                 (!TmpV[i].empty()) &&
-                 (std::all_of(TmpV[i].begin(), TmpV[i].end(), ::isdigit))){
-            pos = i;
-          }
-          FinalStr = TmpV[0];
-          for( unsigned i=1; i<pos; i++ ){
-            FinalStr += ".";
-            FinalStr += TmpV[i];
-          }
-
-          if( FinalStr == Component ){
-            // get the second to last vector element
-            // this is where the clock cycle is stored
-            if( TmpV.size() >= 3 ){
-              v.push_back(std::stoi(TmpV[TmpV.size()-2]));
-            }
-          }
-        }
-      }
-      closedir(dir);
-    }
+    __scan_dumps(true, [&](const std::string& C, SSTCYCLE Cycle){
+      if( C == Component )
+        v.push_back(Cycle);
+    });
 
     // make the vector unique
+    std::sort(v.begin(), v.end());
     v.erase( std::unique( v.begin(), v.end() ), v.end() );
 
     return v;
   }
 
   /// SSTDebug: SST Debug retrieve the set of current component names
+  /// The components writing to the per-thread shards of an MPI rank are included
   std::vector<std::string> GetComponents(){
-    DIR *dir;
-    struct dirent *ent;
-#ifdef SSTDBG_ASCII
-    std::string delim = ".out";
-#else
-    std::string delim = ".json";
-#endif
     std::vector<std::string> v;
-
-    if((dir = opendir(Path.c_str())) != NULL){
-      while((ent = readdir(dir)) != NULL){
-        std::string tmp(ent->d_name);
-        if(tmp.find(delim.c_str()) != std::string::npos){
-          // positive match, split the name
-          std::vector<std::string> TmpV;
-          SplitStr(tmp,'.',TmpV);
-
-          // we have the vector of tokens,
-          // concat everything until we find an integer
-          std::string FinalStr;
-          unsigned i = 0;
-          unsigned pos = 0;
-          while( (i<TmpV.size()) &&
-                 (!TmpV[i].empty()) &&
-                 (std::all_of(TmpV[i].begin(), TmpV[i].end(), ::isdigit))){
-            pos = i;
-          }
-          FinalStr = TmpV[0];
-          for( unsigned i=1; i<pos; i++ ){
-            FinalStr += ".";
-            FinalStr += TmpV[i];
-          }
-
-          v.push_back(FinalStr);
-        }
-      }
-      closedir(dir);
-    }
+    __scan_dumps(true, [&](const std::string& C, SSTCYCLE){
+      v.push_back(C);
+    });
 
     // make the vector unique
+    std::sort(v.begin(), v.end());
     v.erase( std::unique( v.begin(), v.end() ), v.end() );
 
     return v;
   }
 
   /// SSTDebug: SST Debug retrieve the values from the ASCII target component at the target clock cycle
+  /// Values written to the per-thread shards of an MPI rank are merged
   SSTVALUE GetASCIIDebugValues(std::string Component,
                                SSTCYCLE Cycle){
     SSTVALUE v;
     std::ifstream Input;
     std::string BinName = Component + "." + std::to_string(Cycle) + ".out";
-    Input.open(BinName.c_str());
-    if( !Input.is_open() )
+    Input.open(__path(BinName).c_str());
+    if( Input.is_open() ){
+      __read_ascii(Input, "", v);
       return v;
-
-    std::string line;
-    std::vector<std::string> tmp;
-    while( std::getline(Input,line) ){
-      // split the line into two tokens: CSV format
-      SplitStr(line,',',tmp);
-      if( tmp.size() == 2 ){
-        v.push_back(std::pair<std::string,std::string>(tmp[0],tmp[1]));
-      }
-      tmp.clear();
     }
 
-    Input.close();
+    for( auto const& Shard : __shards(Cycle, ".out") ){
+      std::ifstream In(__path(Shard).c_str());
+      __read_ascii(In, Component, v);
+    }
     return v;
   }
 
   /// SSTDebug: SST Debug retrieve the values from the JSON target component at the target clock cycle
+  /// Values written to the per-thread shards of an MPI rank are merged
   SSTVALUE GetJSONDebugValues(std::string Component,
                               SSTCYCLE Cycle){
     SSTVALUE v;
     std::ifstream Input;
     std::string BinName = Component + "." + std::to_string(Cycle) + ".json";
-    Input.open(BinName.c_str());
-    if( !Input.is_open() )
-      return v;
-
-    std::string line;
-    std::vector<std::string> tmp;
-    // retrieve the first line
-    std::getline(Input,line);
-    if( line != "}" ){
-      Input.close();
+    Input.open(__path(BinName).c_str());
+    if( Input.is_open() ){
+      __read_json(Input, Component, v);
       return v;
     }
 
-    while( std::getline(Input,line) ){
-      if( line == "}" ){
-        Input.close();
-        return v;
-      }
-      SplitStr(line,':',tmp);
-      if( tmp.size() == 2 ){
-        tmp[0].erase(std::remove(tmp[0].begin(),tmp[0].end(),'\"'),tmp[0].end());
-        tmp[1].erase(std::remove(tmp[1].begin(),tmp[1].end(),'\"'),tmp[1].end());
-        tmp[1].erase(std::remove(tmp[1].begin(),tmp[1].end(),','),tmp[1].end());
-        v.push_back(std::pair<std::string,std::string>(tmp[0],tmp[1]));
-      }
-      tmp.clear();
+    for( auto const& Shard : __shards(Cycle, ".json") ){
+      std::ifstream In(__path(Shard).c_str());
+      __read_json(In, Component, v);
     }
-
-    Input.close();
     return v;
   }
 
-
-
   /// SSTDebug: SST Debug retrieve the values from the target component at the target clock cycle
   SSTVALUE GetDebugValues(std::string Component,
                           SSTCYCLE Cycle){
@@ -452,6 +1627,23 @@ public:
     return GetJSONDebugValues(Component,Cycle);
 #endif
   }
+
+  /// SSTDebug: SST Debug retrieve a single value by path at the target clock cycle
+  /// Query is component/key or component/scope/.../key; returns false if
+  /// the value does not exist
+  bool GetDebugValue(std::string Query, SSTCYCLE Cycle, std::string& Value){
+    auto pos = Query.find('/');
+    if( pos == std::string::npos )
+      return false;
+    const std::string Key = Query.substr(pos+1);
+    for( auto const& P : GetDebugValues(Query.substr(0,pos), Cycle) ){
+      if( P.first == Key ){
+        Value = P.second;
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 #endif  // #ifndef _SSTDEBUG_H_
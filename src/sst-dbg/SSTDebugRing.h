@@ -0,0 +1,362 @@
+//
+// _SSTDEBUGRING_H_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SSTDEBUGRING_H_
+#define _SSTDEBUGRING_H_
+
+// -- CXX Headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// SSTDebugRing: multi-producer, single-consumer ring of framed dump
+// records in a named shared memory region (shm_open)
+//
+// Layout: a header page followed by a power-of-two data region.  A
+// producer reserves space by advancing Head with a CAS, marks the frame
+// busy with its length and pid, copies its payload and then publishes it
+// by storing the frame's Ready word.  A reservation that would wrap the
+// end of the data region is preceded by a pad frame.  The consumer reads
+// frames in order from Tail, zeroes every byte it has consumed and then
+// advances Tail, so a reserved region always starts out zeroed.  When the
+// ring is full the record is dropped and counted; producers never block.
+//
+// A producer that dies holding a reservation would stall the consumer.
+// A busy frame whose pid no longer exists is skipped; a reservation that
+// was never marked busy is discarded, with everything reserved after it,
+// once Tail has been stuck for StaleWait.  Both are counted as dropped.
+//
+// The consumer records its pid when it attaches and removes the name when
+// it closes; a producer that created the ring removes the name at exit if
+// no consumer ever attached.
+//
+// Frame: [Ready:u32][Length:u32][Pid:u32][pad:u32][payload, padded to 16 bytes]
+// Payload of a record frame: [Cycle:u64][NameLen:u32][Name][Text]
+class SSTDebugRing {
+public:
+  static constexpr uint32_t Magic   = 0x53534452;  ///< "SSDR"
+  static constexpr uint32_t Version = 2;
+
+  /// Frame states stored in the Ready word
+  static constexpr uint32_t FrameEmpty  = 0;
+  static constexpr uint32_t FrameRecord = 1;
+  static constexpr uint32_t FramePad    = 2;
+  static constexpr uint32_t FrameBusy   = 3;
+
+  /// SSTDebugRing: a consumed record
+  typedef struct{
+    uint64_t Cycle;
+    std::string Name;
+    std::string Text;
+  }RECORD;
+
+  SSTDebugRing() = default;
+  ~SSTDebugRing(){ Close(); }
+
+  SSTDebugRing(const SSTDebugRing&) = delete;
+  SSTDebugRing& operator=(const SSTDebugRing&) = delete;
+
+  /// SSTDebugRing: opens (creating if needed) the named ring
+  /// Bytes is the size of the data region used when creating the ring
+  bool Open(const std::string& ShmName, uint64_t Bytes = (64ull << 20)){
+    Close();
+
+    uint64_t Cap = 4096;
+    while( Cap < Bytes )
+      Cap <<= 1;
+
+    int fd = shm_open(ShmName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    bool Creator = (fd != -1);
+    if( !Creator )
+      fd = shm_open(ShmName.c_str(), O_RDWR, 0600);
+    if( fd == -1 )
+      return false;
+
+    if( Creator ){
+      if( ftruncate(fd, (off_t)(HeaderBytes + Cap)) == -1 ){
+        close(fd);
+        shm_unlink(ShmName.c_str());
+        return false;
+      }
+    }else{
+      // wait for the creator to size the region
+      struct stat St;
+      for( unsigned i=0; ; i++ ){
+        if( fstat(fd, &St) == -1 ){
+          close(fd);
+          return false;
+        }
+        if( (uint64_t)(St.st_size) > HeaderBytes )
+          break;
+        if( i == 1000 ){
+          close(fd);
+          return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      Cap = (uint64_t)(St.st_size) - HeaderBytes;
+    }
+
+    void *Base = mmap(nullptr, HeaderBytes + Cap, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    if( Base == MAP_FAILED ){
+      if( Creator )
+        shm_unlink(ShmName.c_str());
+      return false;
+    }
+
+    Hdr  = (HEADER *)(Base);
+    Data = (uint8_t *)(Base) + HeaderBytes;
+    Size = HeaderBytes + Cap;
+    Name = ShmName;
+    Owner = Creator;
+
+    if( Creator ){
+      Hdr->Capacity = Cap;
+      Hdr->Head.store(0, std::memory_order_relaxed);
+      Hdr->Tail.store(0, std::memory_order_relaxed);
+      Hdr->Dropped.store(0, std::memory_order_relaxed);
+      Hdr->Consumer.store(0, std::memory_order_relaxed);
+      Hdr->Version = Version;
+      Hdr->Magic.store(Magic, std::memory_order_release);
+    }else{
+      for( unsigned i=0; Hdr->Magic.load(std::memory_order_acquire) != Magic; i++ ){
+        if( i == 1000 ){
+          Close();
+          return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      if( Hdr->Version != Version ){
+        Close();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// SSTDebugRing: unmaps the ring
+  void Close(){
+    if( Hdr != nullptr )
+      munmap((void *)(Hdr), Size);
+    Hdr  = nullptr;
+    Data = nullptr;
+    Size = 0;
+  }
+
+  /// SSTDebugRing: removes the shared memory name; the mapping stays valid
+  void Unlink(){
+    if( !Name.empty() )
+      shm_unlink(Name.c_str());
+  }
+
+  /// SSTDebugRing: registers this process as the ring's consumer
+  void Attach(){
+    if( Hdr != nullptr )
+      Hdr->Consumer.store((uint32_t)(getpid()), std::memory_order_release);
+  }
+
+  /// SSTDebugRing: has a consumer ever attached to the ring?
+  bool HasConsumer() const {
+    return Hdr && (Hdr->Consumer.load(std::memory_order_acquire) != 0);
+  }
+
+  bool IsOpen() const { return Hdr != nullptr; }
+
+  /// SSTDebugRing: did this process create the region?
+  bool IsOwner() const { return Owner; }
+
+  /// SSTDebugRing: data region capacity in bytes
+  uint64_t Capacity() const { return Hdr ? Hdr->Capacity : 0; }
+
+  /// SSTDebugRing: number of records dropped because the ring was full
+  uint64_t Dropped() const {
+    return Hdr ? Hdr->Dropped.load(std::memory_order_relaxed) : 0;
+  }
+
+  /// SSTDebugRing: publishes a record; returns false if it was dropped
+  bool Write(const std::string& RecName, uint64_t Cycle, const std::string& Text){
+    if( Hdr == nullptr )
+      return false;
+
+    const uint64_t Cap  = Hdr->Capacity;
+    const uint64_t Len  = sizeof(uint64_t) + sizeof(uint32_t) + RecName.size() + Text.size();
+    const uint64_t Need = Align(FrameBytes + Len);
+    if( Need > Cap / 2 ){
+      Hdr->Dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    // reserve [Head, Head+Pad+Need)
+    uint64_t Head = Hdr->Head.load(std::memory_order_relaxed);
+    uint64_t Pad;
+    do{
+      const uint64_t Pos = Head & (Cap - 1);
+      Pad = (Pos + Need > Cap) ? (Cap - Pos) : 0;
+      if( Head + Pad + Need - Hdr->Tail.load(std::memory_order_acquire) > Cap ){
+        Hdr->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }while( !Hdr->Head.compare_exchange_weak(Head, Head + Pad + Need,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed) );
+
+    if( Pad ){
+      FRAME *P = (FRAME *)(Data + (Head & (Cap - 1)));
+      P->Length = (uint32_t)(Pad - FrameBytes);
+      P->Ready.store(FramePad, std::memory_order_release);
+      Head += Pad;
+    }
+
+    // claim the frame so that the consumer can tell a dead producer's
+    // reservation from one still being copied
+    uint8_t *Pos = Data + (Head & (Cap - 1));
+    FRAME *F = (FRAME *)(Pos);
+    F->Length = (uint32_t)(Len);
+    F->Pid    = (uint32_t)(getpid());
+    F->Ready.store(FrameBusy, std::memory_order_release);
+    uint8_t *P = Pos + FrameBytes;
+    const uint32_t NameLen = (uint32_t)(RecName.size());
+    std::memcpy(P, &Cycle, sizeof(Cycle));                P += sizeof(Cycle);
+    std::memcpy(P, &NameLen, sizeof(NameLen));            P += sizeof(NameLen);
+    std::memcpy(P, RecName.data(), RecName.size());       P += RecName.size();
+    std::memcpy(P, Text.data(), Text.size());
+    F->Ready.store(FrameRecord, std::memory_order_release);
+    return true;
+  }
+
+  /// SSTDebugRing: consumes the next published record (single consumer)
+  /// Returns false if no complete record is available
+  bool Read(RECORD& Rec){
+    if( Hdr == nullptr )
+      return false;
+
+    const uint64_t Cap = Hdr->Capacity;
+    uint64_t Tail = Hdr->Tail.load(std::memory_order_relaxed);
+    while( true ){
+      uint8_t *Pos = Data + (Tail & (Cap - 1));
+      FRAME *F = (FRAME *)(Pos);
+      const uint32_t Ready = F->Ready.load(std::memory_order_acquire);
+      if( (Ready == FrameEmpty) || (Ready == FrameBusy) ){
+        const uint64_t Head = Hdr->Head.load(std::memory_order_acquire);
+        if( (Head == Tail) || !Stale(Tail, F, Ready) )
+          return false;
+        Hdr->Dropped.fetch_add(1, std::memory_order_relaxed);
+        if( Ready == FrameEmpty ){
+          // the frame's length was never written; drop every reservation
+          Discard(Tail, Head);
+          Tail = Head;
+          Hdr->Tail.store(Tail, std::memory_order_release);
+          continue;
+        }
+      }
+
+      const uint64_t Total = Align(FrameBytes + F->Length);
+      bool Found = false;
+      if( Ready == FrameRecord ){
+        const uint8_t *P = Pos + FrameBytes;
+        uint32_t NameLen;
+        std::memcpy(&Rec.Cycle, P, sizeof(Rec.Cycle));    P += sizeof(Rec.Cycle);
+        std::memcpy(&NameLen, P, sizeof(NameLen));        P += sizeof(NameLen);
+        const uint64_t TextLen = F->Length - sizeof(uint64_t) - sizeof(uint32_t) - NameLen;
+        Rec.Name.assign((const char *)(P), NameLen);      P += NameLen;
+        Rec.Text.assign((const char *)(P), TextLen);
+        Found = true;
+      }
+
+      // hand the space back zeroed
+      std::memset(Pos + sizeof(uint32_t), 0, Total - sizeof(uint32_t));
+      F->Ready.store(FrameEmpty, std::memory_order_relaxed);
+      Tail += Total;
+      Hdr->Tail.store(Tail, std::memory_order_release);
+      if( Found )
+        return true;
+    }
+  }
+
+private:
+  static constexpr uint64_t HeaderBytes = 4096;
+  static constexpr uint64_t FrameBytes  = 16;
+
+  typedef struct{
+    std::atomic<uint32_t> Magic;
+    uint32_t Version;
+    uint64_t Capacity;
+    alignas(64) std::atomic<uint64_t> Head;     ///< producers' reservation point
+    alignas(64) std::atomic<uint64_t> Tail;     ///< consumer's read point
+    alignas(64) std::atomic<uint64_t> Dropped;  ///< records dropped while full
+    std::atomic<uint32_t> Consumer;             ///< pid of the attached consumer
+  }HEADER;
+
+  typedef struct{
+    std::atomic<uint32_t> Ready;
+    uint32_t Length;
+    uint32_t Pid;                 ///< producer holding a busy frame
+    uint32_t Reserved;
+  }FRAME;
+
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+                "SSTDebugRing requires lock-free 64-bit atomics");
+  static_assert(sizeof(HEADER) <= HeaderBytes, "SSTDebugRing header too large");
+
+  static uint64_t Align(uint64_t n){ return (n + 15) & ~(uint64_t)(15); }
+
+  /// SSTDebugRing: has the unpublished frame at Tail been abandoned?
+  /// A busy frame is abandoned when its producer has exited
+  bool Stale(uint64_t Tail, const FRAME *F, uint32_t Ready){
+    // time Tail may wait on an unpublished frame before it is checked
+    const auto StaleWait = std::chrono::milliseconds(1000);
+    const auto Now = std::chrono::steady_clock::now();
+    if( Tail != StuckTail ){
+      StuckTail  = Tail;
+      StuckSince = Now;
+      return false;
+    }
+    if( (Now - StuckSince) < StaleWait )
+      return false;
+    if( Ready == FrameBusy )
+      return (kill((pid_t)(F->Pid), 0) == -1) && (errno == ESRCH);
+    return true;
+  }
+
+  /// SSTDebugRing: zeroes the data region between two ring positions
+  void Discard(uint64_t From, uint64_t To){
+    const uint64_t Cap = Hdr->Capacity;
+    while( From < To ){
+      const uint64_t Pos = From & (Cap - 1);
+      const uint64_t n   = std::min(To - From, Cap - Pos);
+      std::memset(Data + Pos, 0, n);
+      From += n;
+    }
+  }
+
+  HEADER *Hdr = nullptr;      ///< mapped header
+  uint8_t *Data = nullptr;    ///< mapped data region
+  uint64_t Size = 0;          ///< mapped bytes
+  std::string Name;           ///< shared memory name
+  bool Owner = false;         ///< did we create the region?
+  uint64_t StuckTail = ~0ull; ///< consumer: Tail last seen waiting on a frame
+  std::chrono::steady_clock::time_point StuckSince;
+};
+
+#endif  // #ifndef _SSTDEBUGRING_H_
+
+// EOF
@@ -0,0 +1,77 @@
+//
+// iface_ascii_test12.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <string>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_ascii_test12";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  SSTDebug Dbg(TEST_NAME,"./");
+  SSTDebug *Msg = Dbg.scope("msg");
+  SSTDebug *Queue = Msg->scope("queue");
+
+  unsigned BAR    = 42;
+  unsigned DEPTH  = 3;
+  unsigned SENT   = 7;
+  uint64_t CYCLE  = 100;
+
+  if( !Msg->IsScope() || (Dbg.scope("msg") != Msg) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // the queue depth is captured with every record
+  Queue->watch("DEPTH", &DEPTH);
+
+  // subcomponents dump before the component writes the record
+  Msg->dump(CYCLE, DARG(SENT));
+  if( !Dbg.dump(CYCLE, DARG(BAR)) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // the scopes do not write files of their own
+  if( (Dbg.GetClockValsByComponent("msg").size() != 0) ||
+      (Dbg.GetClockValsByComponent("queue").size() != 0) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::string Val;
+  if( !Dbg.GetDebugValue(TEST_NAME + "/msg/SENT", CYCLE, Val) ||
+      (Val.find("7") == std::string::npos) ||
+      !Dbg.GetDebugValue(TEST_NAME + "/msg/queue/DEPTH", CYCLE, Val) ||
+      (Val.find("3") == std::string::npos) ||
+      !Dbg.GetDebugValue(TEST_NAME + "/BAR", CYCLE, Val) ||
+      Dbg.GetDebugValue(TEST_NAME + "/msg/BAR", CYCLE, Val) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // values pending from an older cycle keep their own cycle
+  SENT = 8;
+  Msg->dump(CYCLE+1, DARG(SENT));
+  Dbg.dump(CYCLE+2, DARG(BAR));
+  if( !Dbg.GetDebugValue(TEST_NAME + "/msg/Cycle", CYCLE+2, Val) ||
+      (Val.find(std::to_string(CYCLE+1)) == std::string::npos) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,81 @@
+//
+// iface_ascii_test15.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_ascii_test15";
+
+// size of a dump file in bytes
+uint64_t FileSize( const std::string& File ){
+  std::ifstream In(File, std::ifstream::ate | std::ifstream::binary);
+  return In.is_open() ? (uint64_t)(In.tellg()) : 0;
+}
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  // the summary record of every component is appended to the stats file
+  const std::string STATS = TEST_NAME + ".stats";
+  unlink(STATS.c_str());
+  setenv("SSTDBG_STATS", STATS.c_str(), 1);
+
+  {
+    SSTDebug Dbg(TEST_NAME,"./");
+    const std::string Ext = Dbg.IsASCII() ? ".out" : ".json";
+
+    unsigned FOO = 1;
+    double BAR   = 2.5;
+    uint64_t Bytes = 0;
+    for( uint64_t CYCLE=0; CYCLE<3; CYCLE++ ){
+      Dbg.dump(CYCLE, DARG(FOO), DARG(BAR));
+      Bytes += FileSize(TEST_NAME + "." + std::to_string(CYCLE) + Ext);
+    }
+
+    SSTDebugCounters C = Dbg.GetCounters();
+    if( (C.Dumps != 3) || (C.Fields != 6) || (C.Bytes != Bytes) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+
+    // the values of a scope are charged to its root
+    Dbg.scope("msg")->dump(3, DARG(FOO));
+    Dbg.dump(3, DARG(BAR));
+    C = Dbg.GetCounters();
+    SSTDebugCounters T = SSTDebug::GetTotalCounters();
+    if( (C.Dumps != 4) || (C.Fields != 8) || (Dbg.scope("msg")->GetCounters().Dumps != 4) ||
+        (T.Dumps < C.Dumps) || (T.Fields < C.Fields) || (T.Bytes < C.Bytes) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  // the summary is written when the component is destroyed
+  std::ifstream In(STATS);
+  std::stringstream Summary;
+  Summary << In.rdbuf();
+  const std::string Expect = (Summary.str().find("\"Element\"") != std::string::npos) ?
+                             "\"Dumps\": 4" : (TEST_NAME + ".Dumps,4");
+  if( Summary.str().find(Expect) == std::string::npos ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
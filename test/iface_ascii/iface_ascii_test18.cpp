@@ -0,0 +1,70 @@
+//
+// iface_ascii_test18.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <string>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_ascii_test18";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  // two components on different clocks
+  SSTDebug Fast(TEST_NAME + "_fast","./");
+  SSTDebug Slow(TEST_NAME + "_slow","./");
+
+  unsigned FOO = 0;
+  unsigned BAR = 0;
+  SSTCYCLE FastCycle = 0;
+  SSTCYCLE SlowCycle = 0;
+
+  Fast.setSnapshot([&](SSTCYCLE C){ Fast.dump(C, DARG(FOO)); });
+  Slow.setSnapshot([&](SSTCYCLE C){ Slow.dump(C, DARG(BAR)); });
+  SSTDebug::setForkMode(2);
+
+  // each dump request reaches both components at their own cycles
+  for( unsigned i=1; i<=4; i++ ){
+    FastCycle = 1000 * i;
+    SlowCycle = 10 * i + 5;
+    FOO = i;
+    BAR = 100 + i;
+    if( !Fast.dump(FastCycle, DARG(FOO)) || !Slow.dump(SlowCycle, DARG(BAR)) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  SSTDebug::waitSnapshots();
+
+  // one fork per request; each record carries its component's own cycle
+  std::vector<SSTCYCLE> F = Fast.GetClockValsByComponent(TEST_NAME + "_fast");
+  std::vector<SSTCYCLE> S = Slow.GetClockValsByComponent(TEST_NAME + "_slow");
+  if( (F.size() != 4) || (S.size() != 4) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+  for( unsigned i=1; i<=4; i++ ){
+    std::string V1, V2;
+    if( (F[i-1] != 1000 * i) || (S[i-1] != 10 * i + 5) ||
+        !Fast.GetDebugValue(TEST_NAME + "_fast/FOO", F[i-1], V1) ||
+        !Slow.GetDebugValue(TEST_NAME + "_slow/BAR", S[i-1], V2) ||
+        (V1 != std::to_string(i)) || (V2 != std::to_string(100 + i)) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,54 @@
+//
+// iface_ascii_test8.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <string>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_ascii_test8";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  SSTDebug Dbg(TEST_NAME,"./");
+  SSTDebug Dbg2(TEST_NAME + "_sub","./");
+
+  std::string FOO = TEST_NAME;
+  unsigned BAR    = 42;
+  uint64_t CYCLE  = 100;
+
+  // register the snapshot callbacks and enable fork mode
+  Dbg.setSnapshot([&](SSTCYCLE C){ Dbg.dump(C, DARG(FOO), DARG(BAR)); });
+  Dbg2.setSnapshot([&](SSTCYCLE C){ Dbg2.dump(C, DARG(BAR)); });
+  SSTDebug::setForkMode(2);
+
+  for( unsigned i=0; i<4; i++ ){
+    BAR++;
+    if( !Dbg.dump(CYCLE+i, DARG(FOO), DARG(BAR)) ||
+        !Dbg2.dump(CYCLE+i, DARG(BAR)) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  SSTDebug::waitSnapshots();
+
+  std::vector<SSTCYCLE> Clocks = Dbg.GetClockVals();
+  if( Clocks.size() < 4 ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
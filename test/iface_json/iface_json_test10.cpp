@@ -0,0 +1,56 @@
+//
+// iface_json_test10.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test10";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  // the sampling rules are read when the first SSTDebug object is built
+  setenv("SSTDBG_SAMPLE", "*_every:every=2; *_mod:mod=10", 1);
+
+  SSTDebug Dbg(TEST_NAME + "_every","./");
+  SSTDebug Dbg2(TEST_NAME + "_mod","./");
+  SSTDebug Dbg3(TEST_NAME + "_none","./");
+  SSTDebug Dbg4(TEST_NAME + "_prob","./");
+  Dbg4.setSampling(0, 0, 0.0);
+
+  unsigned BAR    = 42;
+  uint64_t CYCLE  = 100;
+
+  for( unsigned i=0; i<20; i++ ){
+    if( !Dbg.dump(CYCLE+i, DARG(BAR)) ||
+        !Dbg2.dump(CYCLE+i, DARG(BAR)) ||
+        !Dbg3.dump(CYCLE+i, DARG(BAR)) ||
+        !Dbg4.dump(CYCLE+i, DARG(BAR)) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  if( (Dbg.GetClockValsByComponent(TEST_NAME + "_every").size() != 10) ||
+      (Dbg.GetClockValsByComponent(TEST_NAME + "_mod").size() != 2) ||
+      (Dbg.GetClockValsByComponent(TEST_NAME + "_none").size() != 20) ||
+      (Dbg.GetClockValsByComponent(TEST_NAME + "_prob").size() != 0) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
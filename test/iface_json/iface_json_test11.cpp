@@ -0,0 +1,78 @@
+//
+// iface_json_test11.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test11";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  // the filter is read when the first SSTDebug object is built
+  setenv("SSTDBG_FILTER", "iface_json_test11.FOO, *.REG*, -*.REG_TMP", 1);
+
+  SSTDebug Dbg(TEST_NAME,"./");
+
+  std::string FOO = TEST_NAME;
+  unsigned BAR    = 42;
+  unsigned REG_A  = 1;
+  unsigned REG_TMP = 2;
+  uint64_t CYCLE  = 100;
+
+  for( unsigned i=0; i<2; i++ ){
+    if( !Dbg.dump(CYCLE+i, DARG(FOO), DARG(BAR), DARG(REG_A), DARG(REG_TMP)) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  SSTVALUE V = Dbg.GetDebugValues(TEST_NAME, CYCLE+1);
+  unsigned Found = 0;
+  for( auto const& P : V ){
+    if( (P.first.find("BAR") != std::string::npos) ||
+        (P.first.find("REG_TMP") != std::string::npos) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+    if( (P.first.find("FOO") != std::string::npos) ||
+        (P.first.find("REG_A") != std::string::npos) )
+      Found++;
+  }
+
+  if( Found != 2 ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // keys that are not literals are matched by their name; the buffer
+  // is reused for a key the filter removes
+  char KEY[16];
+  const char *NAME = KEY;
+  std::strcpy(KEY, "REG_B");
+  Dbg.dump(CYCLE+2, NAME, REG_A);
+  std::strcpy(KEY, "TMP_B");
+  Dbg.dump(CYCLE+3, NAME, REG_A);
+  std::string Val;
+  if( !Dbg.GetDebugValue(TEST_NAME + "/REG_B", CYCLE+2, Val) ||
+      Dbg.GetDebugValue(TEST_NAME + "/TMP_B", CYCLE+3, Val) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
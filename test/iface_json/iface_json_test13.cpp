@@ -0,0 +1,53 @@
+//
+// iface_json_test13.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test13";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  SSTDebug Dbg(TEST_NAME,"./");
+
+  unsigned long long REG[4] = {0, 1, 2, 3};
+  std::vector<std::vector<int>> VEC = {{1, 2}, {3}};
+  std::map<std::string, unsigned> MAP = {{"a", 1}, {"b", 2}};
+  std::deque<std::string> STR = {"x", "y:z"};
+  std::string FOO = "a, b";
+  uint64_t CYCLE  = 100;
+
+  if( !Dbg.dump(CYCLE, DARG(REG), DARG(VEC), DARG(MAP), DARG(STR), DARG(FOO)) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // every container is returned as one value
+  std::string Val;
+  if( !Dbg.GetDebugValue(TEST_NAME + "/REG", CYCLE, Val) || (Val != "[0,1,2,3]") ||
+      !Dbg.GetDebugValue(TEST_NAME + "/VEC", CYCLE, Val) || (Val != "[[1,2],[3]]") ||
+      !Dbg.GetDebugValue(TEST_NAME + "/MAP", CYCLE, Val) || (Val != "[[\"a\",1],[\"b\",2]]") ||
+      !Dbg.GetDebugValue(TEST_NAME + "/STR", CYCLE, Val) || (Val != "[\"x\",\"y:z\"]") ||
+      !Dbg.GetDebugValue(TEST_NAME + "/FOO", CYCLE, Val) || (Val != "a, b") ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
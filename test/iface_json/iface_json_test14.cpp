@@ -0,0 +1,65 @@
+//
+// iface_json_test14.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test14";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  const unsigned THREADS = 8;
+  const unsigned COMPS   = 4;
+  const unsigned CYCLES  = 16;
+
+  // components on every thread dump the same cycles at the same time
+  std::vector<std::thread> Threads;
+  for( unsigned t=0; t<THREADS; t++ ){
+    Threads.emplace_back([=](){
+      std::vector<std::unique_ptr<SSTDebug>> Dbg;
+      for( unsigned c=0; c<COMPS; c++ )
+        Dbg.emplace_back(new SSTDebug(TEST_NAME + "_" + std::to_string(t*COMPS+c),"./"));
+      std::string PAD(1024, 'x');
+      for( uint64_t CYCLE=0; CYCLE<CYCLES; CYCLE++ ){
+        for( unsigned c=0; c<COMPS; c++ ){
+          unsigned ID = t*COMPS+c;
+          Dbg[c]->dump(CYCLE, DARG(ID), DARG(PAD));
+        }
+      }
+    });
+  }
+  for( auto& T : Threads )
+    T.join();
+
+  // every record is complete and belongs to its component
+  SSTDebug Dbg(TEST_NAME,"./");
+  for( unsigned ID=0; ID<THREADS*COMPS; ID++ ){
+    for( uint64_t CYCLE=0; CYCLE<CYCLES; CYCLE++ ){
+      std::string Comp = TEST_NAME + "_" + std::to_string(ID);
+      std::string Val;
+      if( !Dbg.GetDebugValue(Comp + "/ID", CYCLE, Val) || (Val != std::to_string(ID)) ||
+          !Dbg.GetDebugValue(Comp + "/PAD", CYCLE, Val) || (Val.size() != 1024) ){
+        std::cout << "FAIL" << std::endl;
+        return -1;
+      }
+    }
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
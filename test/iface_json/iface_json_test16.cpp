@@ -0,0 +1,55 @@
+//
+// iface_json_test16.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test16";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  SSTDebug Dbg(TEST_NAME,"./");
+
+  unsigned long long REG[32];
+  unsigned long long MASK[8] = {0};
+  for( unsigned i=0; i<32; i++ )
+    REG[i] = i;
+  uint64_t CYCLE = 100;
+
+  // Count is the number of array elements watched
+  Dbg.watch("REG", &REG, 32);
+  Dbg.watch("MASK", &MASK, 2);
+
+  REG[31] = 77;
+  if( !Dbg.snapshot(CYCLE) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::string Val;
+  const char Sep = Dbg.IsASCII() ? ';' : ',';
+  if( !Dbg.GetDebugValue(TEST_NAME + "/REG", CYCLE, Val) ||
+      (std::count(Val.begin(), Val.end(), Sep) != 31) ||
+      (Val.find(std::string(1, Sep) + "77]") == std::string::npos) ||
+      !Dbg.GetDebugValue(TEST_NAME + "/MASK", CYCLE, Val) ||
+      (Val != "[0" + std::string(1, Sep) + "0]") ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,109 @@
+//
+// iface_json_test17.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test17";
+
+static bool Has( const std::vector<std::string>& v, const std::string& s ){
+  return std::find(v.begin(), v.end(), s) != v.end();
+}
+
+static bool HasKey( const SSTVALUE& v, const std::string& k ){
+  for( auto const& i : v )
+    if( i.first == k )
+      return true;
+  return false;
+}
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  // component names holding dots and leading digits
+  SSTDebug Dotted(TEST_NAME + ".cpu.core0","./");
+  SSTDebug Digits("0.17." + TEST_NAME,"./");
+
+  uint64_t CYCLE = 100;
+  unsigned BAR   = 42;
+  Dotted.dump(CYCLE, DARG(BAR));
+  Dotted.dump(CYCLE+1, DARG(BAR));
+  Digits.dump(CYCLE+2, DARG(BAR));
+
+  // a per-thread shard of an MPI rank holding the records of two components
+  const std::string SA = TEST_NAME + "_shard_a";
+  const std::string SB = TEST_NAME + "_shard_b";
+  const std::string SX = SA + ".x";   // a dotted key of SA names a component
+  if( Dotted.IsASCII() ){
+    std::ofstream Out("SSTDbg.0.t0.200.out");
+    Out << "#Element," << SA << std::endl
+        << "BAR,1" << std::endl
+        << "s.x,4" << std::endl
+        << "#Element," << SB << std::endl
+        << "BAR,2" << std::endl
+        << "scope/BAZ,3" << std::endl
+        << "#Element," << SX << std::endl
+        << "Z,2" << std::endl;
+  }else{
+    std::ofstream Out("SSTDbg.0.t0.200.json");
+    for( auto const& C : {SA, SB, SX} ){
+      Out << "{" << std::endl
+          << "\"Element\": \"" << C << "\"," << std::endl
+          << "\"Cycle\": 200," << std::endl
+          << "\"BAR\": 1" << std::endl
+          << "}" << std::endl;
+    }
+  }
+
+  std::vector<std::string> Comps = Dotted.GetComponents();
+  for( auto i : Comps )
+    std::cout << i << std::endl;
+  if( !Has(Comps, TEST_NAME + ".cpu.core0") || !Has(Comps, "0.17." + TEST_NAME) ||
+      !Has(Comps, SA) || !Has(Comps, SB) || !Has(Comps, SX) ||
+      Has(Comps, SA + ".s") || Has(Comps, "SSTDbg.0.t0") ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::vector<SSTCYCLE> Clocks = Dotted.GetClockValsByComponent(TEST_NAME + ".cpu.core0");
+  if( (Clocks.size() != 2) || (Clocks[0] != CYCLE) || (Clocks[1] != CYCLE+1) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+  Clocks = Dotted.GetClockValsByComponent("0.17." + TEST_NAME);
+  if( (Clocks.size() != 1) || (Clocks[0] != CYCLE+2) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+  Clocks = Dotted.GetClockValsByComponent(SB);
+  if( (Clocks.size() != 1) || (Clocks[0] != 200) ||
+      Dotted.GetDebugValues(SB, 200).empty() ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // components are matched exactly; SX's values are not SA's
+  SSTVALUE V = Dotted.GetDebugValues(SA, 200);
+  if( !HasKey(V, "BAR") || HasKey(V, "x.Z") || HasKey(V, "Z") ||
+      (Dotted.IsASCII() && !HasKey(V, "s.x")) ||
+      !HasKey(Dotted.GetDebugValues(SX, 200), Dotted.IsASCII() ? "Z" : "BAR") ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,69 @@
+//
+// iface_json_test9.cpp
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <iostream>
+#include <string>
+#include "SSTDebug.h"
+
+std::string TEST_NAME = "iface_json_test9";
+
+int main( int argc, char **argv ){
+  std::cout << "TEST = " << __FILE__ << std::endl;
+
+  SSTDebug Dbg(TEST_NAME,"./");
+
+  std::string FOO = TEST_NAME;
+  unsigned BAR    = 42;
+  uint64_t REG[4] = {0, 1, 2, 3};
+  uint64_t CYCLE  = 100;
+
+  // register the watch variables once
+  Dbg.watch("FOO", &FOO);
+  Dbg.watch("BAR", &BAR);
+  Dbg.watch("REG", &REG);
+
+  if( Dbg.getWatchCount() != 3 ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  BAR = 43;
+  REG[3] = 7;
+  if( !Dbg.snapshot(CYCLE) ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  // Element, Cycle, FOO, BAR and REG
+  SSTVALUE V = Dbg.GetDebugValues(TEST_NAME, CYCLE);
+  if( V.size() != 5 ){
+    std::cout << "FAIL" << std::endl;
+    return -1;
+  }
+
+  for( auto const& P : V ){
+    if( (P.first.find("BAR") != std::string::npos) &&
+        (P.second.find("43") == std::string::npos) ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+    // the array is written as a single value
+    if( (P.first == "REG") && (P.second != "[0,1,2,7]") ){
+      std::cout << "FAIL" << std::endl;
+      return -1;
+    }
+  }
+
+  std::cout << "PASS" << std::endl;
+
+  return 0;
+}
+
+// EOF